@@ -1,6 +1,7 @@
 #include <CLI/CLI.hpp>
 
 #include <core/engine.h>
+#include <core/producer_factory.h>
 
 #include <core/util/logger.h>
 
@@ -31,6 +32,7 @@ struct AcquireOptions
   bool verbose{false};
   std::string save_h5;
   std::string save_csv;
+  std::string replay;
 
   AcquireOptions()
   {
@@ -43,9 +45,26 @@ struct AcquireOptions
     app.add_flag("-v,--verbose", verbose, "Print results");
     app.add_option("-s,--save", save_h5, "Save to h5 file");
     app.add_option("-c,--save_csv", save_csv, "Save to multiple csv files");
+    app.add_option("-r,--replay", replay, "Replay recorded list mode file(s) instead of acquiring")
+        ->check(CLI::ExistingFile);
   }
 };
 
+// adds a ListReplay producer to the profile, runs until the recording ends
+nlohmann::json add_replay(const nlohmann::json& profile, std::string path)
+{
+  auto producer = ProducerFactory::singleton().create_type("ListReplay");
+  if (!producer)
+    throw std::runtime_error("ListReplay producer not available");
+  Setting replay = producer->settings();
+  replay.set(Setting::text("ListReplay/Path", path));
+  replay.set_text("replay");
+
+  Setting tree = profile;
+  tree.branches.add_a(replay);
+  return tree;
+}
+
 int main(int argc, char** argv)
 {
   AcquireOptions opts;
@@ -66,12 +85,15 @@ int main(int argc, char** argv)
 
   auto& engine = Engine::singleton();
 
-  if (!opts.profile_file.empty())
+  if (!opts.profile_file.empty() || !opts.replay.empty())
   {
-    nlohmann::json profile;
+    nlohmann::json profile = Engine::default_settings();
     try
     {
-      profile = from_json_file(opts.profile_file);
+      if (!opts.profile_file.empty())
+        profile = from_json_file(opts.profile_file);
+      if (!opts.replay.empty())
+        profile = add_replay(profile, opts.replay);
       engine.initialize(profile);
     }
     catch (std::exception& e)
@@ -112,6 +134,7 @@ int main(int argc, char** argv)
     std::stringstream ss;
     ss << *project;
     INFO("Project after DAQ run:\n{}", ss.str());
+    INFO("Consumer binning cost:\n{}", project->profile_report());
   }
 
   if (!opts.save_h5.empty())
@@ -1,4 +1,5 @@
 #include <consumers/add_ons/filter_block.h>
+#include <algorithm>
 
 namespace DAQuiri {
 
@@ -42,13 +43,24 @@ Setting FilterBlock::settings() const
 void FilterBlock::configure(const Spill& spill)
 {
   valid = false;
+  selection.clear();
   for (auto& f : filters_)
   {
     if (f.enabled_)
       f.configure(spill);
-    if (f.valid())
-      valid = true;
+    if (!f.valid())
+      continue;
+    valid = true;
+    selection.push_back({static_cast<size_t>(f.idx_), f.min_, f.max_});
   }
+  std::sort(selection.begin(), selection.end());
+}
+
+const uint8_t* FilterBlock::mask(SpillCache* cache, const Spill& spill, size_t end) const
+{
+  if (!valid || !cache)
+    return nullptr;
+  return cache->mask(spill, selection, end);
 }
 
 }
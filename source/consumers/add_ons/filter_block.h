@@ -1,6 +1,7 @@
 #pragma once
 
 #include <consumers/add_ons/value_filter.h>
+#include <core/spill_cache.h>
 
 namespace DAQuiri {
 
@@ -11,18 +12,31 @@ struct FilterBlock
 
   void configure(const Spill& spill);
 
+  //selection of events [0, end) shared through cache, nullptr if none
+  const uint8_t* mask(SpillCache* cache, const Spill& spill, size_t end) const;
+
   inline bool accept(const Event& event) const
   {
-    if (!valid)
-      return true;
-    for (auto& f : filters_)
-      if (!f.accept(event))
-        return false;
+    return preselected || passes(event);
+  }
+
+  //evaluates the filters even if preselected
+  inline bool passes(const Event& event) const
+  {
+    if (valid)
+      for (auto& f : filters_)
+        if (!f.accept(event))
+          return false;
     return true;
   }
 
   std::vector<ValueFilter> filters_;
   bool valid {false};
+
+  //valid filters as resolved by configure, comparable across consumers
+  SpillCache::Selection selection;
+  //events were already checked by the caller, accept() passes them all
+  bool preselected {false};
 };
 
 }
@@ -0,0 +1,145 @@
+#include <consumers/add_ons/shards.h>
+#include <algorithm>
+
+namespace DAQuiri {
+
+void Shards::settings(const Setting& s)
+{
+  auto c = s.find(Setting("shards"));
+  if (c)
+    count = static_cast<size_t>(std::max(integer_t(1), c.get_int()));
+  auto m = s.find(Setting("shard_merge"));
+  if (m)
+    merge_every = static_cast<size_t>(std::max(integer_t(1), m.get_int()));
+}
+
+Setting Shards::settings() const
+{
+  auto ret = Setting::stem("sharding");
+
+  SettingMeta c("shards", SettingType::integer, "Binning threads");
+  c.set_val("min", 1);
+  c.set_val("max", 64);
+  Setting shards(c);
+  shards.set_int(count);
+  ret.branches.add(shards);
+
+  SettingMeta m("shard_merge", SettingType::integer,
+                "Merge partials every N pushes (and at end of spill)");
+  m.set_val("min", 1);
+  Setting merge(m);
+  merge.set_int(merge_every);
+  ret.branches.add(merge);
+
+  return ret;
+}
+
+ShardPool::~ShardPool()
+{
+  resize(0);
+}
+
+void ShardPool::resize(size_t workers)
+{
+  if (workers == threads_.size())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& t : threads_)
+    t.join();
+  threads_.clear();
+  stop_ = false;
+
+  for (size_t i = 0; i < workers; ++i)
+    threads_.emplace_back(&ShardPool::loop, this, i + 1, round_);
+}
+
+void ShardPool::run(const std::function<void(size_t)>& job)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_ = &job;
+    pending_ = threads_.size();
+    round_++;
+  }
+  wake_.notify_all();
+
+  job(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return !pending_; });
+  job_ = nullptr;
+}
+
+void ShardPool::loop(size_t index, uint64_t seen)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    wake_.wait(lock, [&] { return stop_ || (round_ != seen); });
+    if (stop_)
+      return;
+    seen = round_;
+    auto job = job_;
+    lock.unlock();
+    (*job)(index);
+    lock.lock();
+    if (!--pending_)
+      done_.notify_one();
+  }
+}
+
+void Shards::reset()
+{
+  source_ = nullptr;
+  partials_.clear();
+  unmerged_ = 0;
+  pool_.reset();
+}
+
+void Shards::prepare(DataspacePtr data)
+{
+  if (!pool_)
+    pool_.reset(new ShardPool);
+  pool_->resize(count - 1);
+
+  if (dynamic_cast<AtomicDense*>(data.get()))
+    return;
+
+  if ((source_ != data.get()) || (partials_.size() + 1 != count))
+  {
+    //owner merges before replacing data or changing count
+    partials_.clear();
+    source_ = data.get();
+    unmerged_ = 0;
+  }
+
+  while (partials_.size() + 1 < count)
+  {
+    DataspacePtr p(data->clone());
+    p->clear();
+    partials_.push_back(p);
+  }
+}
+
+void Shards::merge(DataspacePtr data)
+{
+  unmerged_ = 0;
+  if (source_ != data.get())
+    return;
+  for (auto& p : partials_)
+  {
+    if (p->empty())
+      continue;
+    auto entries = p->range({});
+    for (const auto& e : *entries)
+      data->add(e);
+    p->clear();
+  }
+}
+
+}
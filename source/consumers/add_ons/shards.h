@@ -0,0 +1,174 @@
+#pragma once
+
+#include <consumers/add_ons/filter_block.h>
+#include <consumers/dataspaces/atomic_dense.h>
+#include <consumers/dataspaces/mapped_dense.h>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace DAQuiri {
+
+// Threads kept for repeated fan-out: run() hands job(1..size) to the
+// workers, runs job(0) on the caller and returns once all are done.
+class ShardPool
+{
+  public:
+    ShardPool() {}
+    ShardPool(const ShardPool&) = delete;
+    ShardPool& operator=(const ShardPool&) = delete;
+    ~ShardPool();
+
+    // starts or stops workers, only between runs
+    void resize(size_t workers);
+    size_t size() const { return threads_.size(); }
+
+    void run(const std::function<void(size_t)>& job);
+
+  private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(size_t)>* job_ {nullptr};
+    uint64_t round_ {0};
+    size_t pending_ {0};
+    bool stop_ {false};
+
+    void loop(size_t index, uint64_t seen);
+};
+
+// Bins a range of events on worker threads kept between pushes. The
+// calling thread bins its slice straight into the consumer's dataspace,
+// the others into partial copies. Partials are folded back in every
+// merge_every pushes and whenever the owner calls merge(), which consumers
+// do at the end of each spill, so the result is the same as binning
+// serially. An AtomicDense backend is filled by all threads directly.
+// MappedDense is binned serially, each partial would be a scratch file the
+// size of the detector.
+class Shards
+{
+  public:
+    Shards() {}
+    //partials and threads belong to one consumer, copies start without them
+    Shards(const Shards& other)
+      : count(other.count)
+      , merge_every(other.merge_every)
+      , min_events_per_shard(other.min_events_per_shard)
+    {}
+    Shards& operator=(const Shards& other)
+    {
+      count = other.count;
+      merge_every = other.merge_every;
+      min_events_per_shard = other.min_events_per_shard;
+      reset();
+      return *this;
+    }
+
+    void settings(const Setting& s);
+    Setting settings() const;
+
+    // worth spreading this many events over threads?
+    inline bool parallel(size_t events, const Dataspace& data) const
+    {
+      return (count > 1) && (events >= count * min_events_per_shard)
+          && !dynamic_cast<const MappedDense*>(&data);
+    }
+
+    // extract(event, coords) fills in coords for an accepted event,
+    // returns how many events were accepted
+    template<typename Extract>
+    size_t bin(std::vector<Event>::const_iterator first,
+               std::vector<Event>::const_iterator last,
+               DataspacePtr data, const FilterBlock& filters,
+               size_t dimensions, Extract extract);
+
+    // folds partials binned so far into data
+    void merge(DataspacePtr data);
+
+    // drops partials and stops the threads, e.g. when the dataspace is
+    // replaced
+    void reset();
+
+    // Parameters
+    size_t count {1};
+    size_t merge_every {1};
+    size_t min_events_per_shard {1024};
+
+  private:
+    const Dataspace* source_ {nullptr};
+    std::vector<DataspacePtr> partials_;
+    size_t unmerged_ {0};
+    std::unique_ptr<ShardPool> pool_;
+
+    void prepare(DataspacePtr data);
+};
+
+template<typename Extract>
+size_t Shards::bin(std::vector<Event>::const_iterator first,
+                   std::vector<Event>::const_iterator last,
+                   DataspacePtr data, const FilterBlock& filters,
+                   size_t dimensions, Extract extract)
+{
+  //atomic cells can be shared by all threads, no partials needed
+  auto shared = dynamic_cast<AtomicDense*>(data.get());
+  prepare(data);
+
+  auto total = static_cast<size_t>(last - first);
+  auto slice = total / count;
+
+  //bins beyond an atomic backend's extent, added once threads are done
+  std::vector<std::vector<Coords>> overflow(count);
+  std::vector<size_t> accepted(count, 0);
+
+  std::function<void(size_t)> work = [&](size_t shard)
+  {
+    auto from = first + shard * slice;
+    auto to = (shard + 1 == count) ? last : (from + slice);
+    Dataspace* into = data.get();
+    if (!shared && shard)
+      into = partials_[shard - 1].get();
+    Coords coords(dimensions, 0);
+    size_t n = 0;
+    for (auto e = from; e != to; ++e)
+    {
+      if (!filters.accept(*e))
+        continue;
+      n++;
+      extract(*e, coords);
+      if (!shared)
+        into->add_one(coords);
+      else if (!shared->add_concurrent(coords))
+        overflow[shard].push_back(coords);
+    }
+    accepted[shard] = n;
+  };
+
+  pool_->run(work);
+
+  size_t ret = 0;
+  for (auto a : accepted)
+    ret += a;
+
+  size_t spilled = 0;
+  for (const auto& o : overflow)
+  {
+    spilled += o.size();
+    for (const auto& c : o)
+      data->add_one(c);
+  }
+
+  if (shared)
+  {
+    shared->count_concurrent(ret - spilled);
+    data->recalc_axes();
+  }
+  else if (++unmerged_ >= merge_every)
+    merge(data);
+
+  return ret;
+}
+
+}
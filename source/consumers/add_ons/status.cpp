@@ -10,7 +10,7 @@ Status Status::extract(const Spill& spill)
   ret.type = spill.type;
   ret.producer_time = spill.time;
   ret.consumer_time = std::chrono::system_clock::now();
-  ret.timebase = spill.event_model.timebase;
+  ret.timebase = spill.event_model->timebase;
   Setting native_time = spill.state.find(Setting("native_time"));
   if (native_time)
     ret.stats["native_time"] = native_time;
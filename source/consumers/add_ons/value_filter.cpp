@@ -8,6 +8,7 @@ void ValueFilter::settings(const Setting& s)
   if (name != name_)
   {
     idx_ = -1;
+    model_id_ = 0;
     name_ = name;
   }
 
@@ -55,8 +56,12 @@ Setting ValueFilter::settings(int32_t index) const
 
 void ValueFilter::configure(const Spill& spill)
 {
-  if (spill.event_model.name_to_val.count(name_))
-    idx_ = spill.event_model.name_to_val.at(name_);
+  if (spill.event_model.id() == model_id_)
+    return;
+  model_id_ = spill.event_model.id();
+  auto it = spill.event_model->name_to_val.find(name_);
+  if (it != spill.event_model->name_to_val.end())
+    idx_ = static_cast<int>(it->second);
   else
     idx_ = -1;
 }
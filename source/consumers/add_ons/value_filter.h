@@ -15,8 +15,8 @@ struct ValueFilter
   {
     if (!valid())
       return true;
-    value_ = event.value(idx_);
-    return ((value_ >= min_) && (value_ <= max_));
+    auto value = event.value(idx_);
+    return ((value >= min_) && (value <= max_));
   }
 
   inline bool valid() const
@@ -30,8 +30,8 @@ struct ValueFilter
   uint32_t max_{std::numeric_limits<int32_t>::max()};
 
   int idx_{-1};
-
-  mutable uint32_t value_;
+  //event model idx_ was resolved against
+  uint64_t model_id_{0};
 };
 
 }
@@ -8,6 +8,7 @@ void ValueLatch::settings(const Setting& s)
   if (name != value_id)
   {
     idx = -1;
+    model_id_ = 0;
     value_id = name;
   }
   downsample = static_cast<uint16_t>(s.find(Setting("value_latch/downsample")).get_int());
@@ -45,8 +46,12 @@ Setting ValueLatch::settings(int32_t index, std::string override_name) const
 
 void ValueLatch::configure(const Spill& spill)
 {
-  if (has_declared_value(spill))
-    idx = static_cast<int32_t>(spill.event_model.name_to_val.at(value_id));
+  if (spill.event_model.id() == model_id_)
+    return;
+  model_id_ = spill.event_model.id();
+  auto it = spill.event_model->name_to_val.find(value_id);
+  if (it != spill.event_model->name_to_val.end())
+    idx = static_cast<int32_t>(it->second);
   else
     idx = -1;
 }
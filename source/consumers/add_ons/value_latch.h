@@ -1,6 +1,6 @@
 #pragma once
 
-#include <core/spill.h>
+#include <core/spill_cache.h>
 
 namespace DAQuiri {
 
@@ -12,7 +12,8 @@ struct ValueLatch
 
     inline bool has_declared_value(const Spill& spill)
     {
-      return (0 != spill.event_model.name_to_val.count(value_id));
+      configure(spill);
+      return valid();
     }
 
     void configure(const Spill& spill);
@@ -31,11 +32,29 @@ struct ValueLatch
       return (idx >= 0);
     }
 
+    //extract() of events [0, end) shared through cache, nullptr if none
+    inline const uint32_t* column(SpillCache* cache, const Spill& spill, size_t end) const
+    {
+      if (!valid() || !cache)
+        return nullptr;
+      return cache->column(spill, static_cast<size_t>(idx), downsample, end);
+    }
+
+    //largest bin extract() can produce for the configured spill
+    inline uint32_t max_bin(const Spill& spill) const
+    {
+      if (!valid() || (static_cast<size_t>(idx) >= spill.event_model->maximum.size()))
+        return 0;
+      return spill.event_model->maximum[static_cast<size_t>(idx)] >> downsample;
+    }
+
     std::string value_id;
     uint16_t downsample {0};
 
   private:
     int32_t idx {-1};
+    //event model idx was resolved against
+    uint64_t model_id_ {0};
 };
 
 }
@@ -0,0 +1,348 @@
+#include <consumers/dataspaces/atomic_dense.h>
+#include <core/util/h5json.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace DAQuiri {
+
+namespace {
+
+size_t next_pow2(size_t n)
+{
+  size_t ret{1};
+  while (ret < n)
+    ret <<= 1;
+  return ret;
+}
+
+//odometer over [mins, maxs], last coordinate fastest; false when done
+bool next_cell(Coords& c, const Coords& mins, const Coords& maxs)
+{
+  for (size_t d = c.size(); d > 0; --d)
+  {
+    if (c[d - 1] < maxs[d - 1])
+    {
+      ++c[d - 1];
+      return true;
+    }
+    c[d - 1] = mins[d - 1];
+  }
+  return false;
+}
+
+size_t volume(const Coords& extent)
+{
+  size_t ret {1};
+  for (const auto& e : extent)
+    ret *= e;
+  return ret;
+}
+
+}
+
+AtomicDense::AtomicDense(uint16_t dimensions)
+    : Dataspace(dimensions)
+    , capacity_(dimensions, 0)
+    , limits_(new std::atomic<size_t>[dimensions])
+{
+  for (size_t i = 0; i < dimensions; ++i)
+    limits_[i] = 0;
+}
+
+AtomicDense::AtomicDense(const AtomicDense& other)
+    : Dataspace(other)
+    , size_(other.size_)
+    , capacity_(other.capacity_)
+    , limits_(new std::atomic<size_t>[other.dimensions()])
+{
+  if (size_)
+    counts_.reset(new std::atomic<uint64_t>[size_]);
+  for (size_t i = 0; i < size_; ++i)
+    counts_[i] = other.counts_[i].load(std::memory_order_relaxed);
+  for (size_t i = 0; i < dimensions(); ++i)
+    limits_[i] = other.limits_[i].load(std::memory_order_relaxed);
+  used_ = other.used_.load();
+}
+
+bool AtomicDense::empty() const
+{
+  return !used_.load(std::memory_order_relaxed);
+}
+
+Coords AtomicDense::limits() const
+{
+  Coords ret(dimensions());
+  for (size_t i = 0; i < ret.size(); ++i)
+    ret[i] = limits_[i].load(std::memory_order_relaxed);
+  return ret;
+}
+
+void AtomicDense::grow(const Coords& new_capacity)
+{
+  auto new_size = volume(new_capacity);
+  std::unique_ptr<std::atomic<uint64_t>[]> grown(new std::atomic<uint64_t>[new_size]);
+  for (size_t i = 0; i < new_size; ++i)
+    grown[i] = 0;
+
+  if (size_ && used_)
+  {
+    Coords mins(dimensions(), 0);
+    Coords c = mins;
+    auto lim = limits();
+    do
+    {
+      auto v = counts_[index(c)].load(std::memory_order_relaxed);
+      if (v)
+        grown[offset(c, new_capacity)] = v;
+    }
+    while (next_cell(c, mins, lim));
+  }
+
+  counts_ = std::move(grown);
+  size_ = new_size;
+  capacity_ = new_capacity;
+}
+
+void AtomicDense::reserve(const Coords& limits)
+{
+  if (limits.size() != dimensions())
+    return;
+  Coords new_capacity = capacity_;
+  bool bigger {false};
+  for (size_t i = 0; i < limits.size(); ++i)
+  {
+    if (limits[i] >= new_capacity[i])
+    {
+      new_capacity[i] = limits[i] + 1;
+      bigger = true;
+    }
+  }
+  //declared extents can be far wider than anything observed
+  if (bigger &&
+      (volume(new_capacity) * sizeof(std::atomic<uint64_t>) <= reserve_budget))
+    grow(new_capacity);
+}
+
+void AtomicDense::clear()
+{
+  for (size_t i = 0; i < size_; ++i)
+    counts_[i] = 0;
+  for (size_t i = 0; i < dimensions(); ++i)
+    limits_[i] = 0;
+  used_ = false;
+  total_count_ = 0;
+}
+
+void AtomicDense::add(const Entry& e)
+{
+  if ((e.first.size() != dimensions()) || !e.second)
+    return;
+  //counters are integers
+  auto count = static_cast<uint64_t>(std::llround(to_double(e.second)));
+  if (!fits(e.first))
+  {
+    Coords new_capacity = capacity_;
+    for (size_t i = 0; i < e.first.size(); ++i)
+      new_capacity[i] = std::max(new_capacity[i], next_pow2(e.first[i] + 1));
+    if (volume(new_capacity) * sizeof(std::atomic<uint64_t>) > reserve_budget)
+      for (size_t i = 0; i < e.first.size(); ++i)
+        new_capacity[i] = std::max(capacity_[i], e.first[i] + 1);
+    grow(new_capacity);
+  }
+  add_concurrent(e.first, count);
+  total_count_ += count;
+}
+
+void AtomicDense::add_one(const Coords& coords)
+{
+  if (add_concurrent(coords))
+    total_count_ += 1;
+  else if (coords.size() == dimensions())
+    add({coords, 1});
+}
+
+PreciseFloat AtomicDense::get(const Coords& coords) const
+{
+  if ((coords.size() != dimensions()) || !fits(coords))
+    return 0;
+  return counts_[index(coords)].load(std::memory_order_relaxed);
+}
+
+EntryList AtomicDense::range(std::vector<Pair> list) const
+{
+  EntryList result(new EntryList_t);
+  if (empty())
+    return result;
+
+  Coords mins(dimensions(), 0);
+  Coords maxs = limits();
+  if (list.size() == dimensions())
+  {
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+      mins[i] = std::min(list[i].first, list[i].second);
+      maxs[i] = std::min(std::max(list[i].first, list[i].second), maxs[i]);
+      if (mins[i] > maxs[i])
+        return result;
+    }
+  }
+
+  Coords c = mins;
+  do
+  {
+    auto v = counts_[index(c)].load(std::memory_order_relaxed);
+    if (v)
+      result->push_back({c, v});
+  }
+  while (next_cell(c, mins, maxs));
+
+  return result;
+}
+
+EntryList AtomicDense::range_binned(std::vector<Pair> list,
+                                    const Coords& resolution) const
+{
+  if (list.size() != dimensions())
+  {
+    list.clear();
+    for (const auto& l : limits())
+      list.push_back({0, l});
+  }
+
+  auto factors = binning_factors(list, resolution);
+  if (std::all_of(factors.begin(), factors.end(),
+                  [](size_t f) { return f == 1; }))
+    return range_unbinned(list);
+
+  TileBuffer tiles(list, factors);
+  if (!tiles.valid())
+    return range(list);
+  if (empty())
+    return tiles.entries();
+
+  //sum cells straight into tiles, up to the largest bins seen
+  Coords mins = tiles.mins();
+  Coords maxs = limits();
+  for (size_t i = 0; i < maxs.size(); ++i)
+  {
+    maxs[i] = std::min(maxs[i], tiles.maxs()[i]);
+    if (mins[i] > maxs[i])
+      return tiles.entries();
+  }
+
+  Coords c = mins;
+  do
+  {
+    auto v = counts_[index(c)].load(std::memory_order_relaxed);
+    if (v)
+      tiles.add(c, v);
+  }
+  while (next_cell(c, mins, maxs));
+
+  return tiles.entries();
+}
+
+void AtomicDense::recalc_axes()
+{
+  auto lim = limits();
+  for (size_t i = 0; i < lim.size(); ++i)
+    fit_axis(i, lim[i]);
+}
+
+void AtomicDense::export_csv(std::ostream& os) const
+{
+  for (const auto& e : *range({}))
+  {
+    for (const auto& c : e.first)
+      os << c << ", ";
+    os << e.second << ";\n";
+  }
+}
+
+void AtomicDense::data_save(const hdf5::node::Group& g) const
+{
+  if (empty())
+    return;
+
+  try
+  {
+    using namespace hdf5;
+
+    auto data = range({});
+    auto dims = static_cast<size_t>(dimensions());
+
+    std::vector<uint32_t> didx(data->size() * dims);
+    std::vector<uint64_t> dcts(data->size());
+    for (size_t i = 0; i < data->size(); ++i)
+    {
+      const auto& e = data->at(i);
+      for (size_t d = 0; d < dims; ++d)
+        didx[i * dims + d] = static_cast<uint32_t>(e.first[d]);
+      dcts[i] = static_cast<uint64_t>(to_double(e.second));
+    }
+
+    auto i_space = dataspace::Simple({data->size(), dims});
+    auto idx = g.create_dataset("indices", datatype::create<uint32_t>(), i_space);
+    idx.write(didx);
+
+    auto c_space = dataspace::Simple({data->size()});
+    auto cts = g.create_dataset("counts", datatype::create<uint64_t>(), c_space);
+    cts.write(dcts);
+  }
+  catch (...)
+  {
+    std::throw_with_nested(std::runtime_error("<AtomicDense> Could not save"));
+  }
+}
+
+void AtomicDense::data_load(const hdf5::node::Group& g)
+{
+  try
+  {
+    using namespace hdf5;
+
+    if (!g.has_dataset("indices") || !g.has_dataset("counts"))
+      return;
+
+    auto idx = hdf5::node::Group(g).get_dataset("indices");
+    auto cts = hdf5::node::Group(g).get_dataset("counts");
+
+    auto shape = dataspace::Simple(idx.dataspace()).current_dimensions();
+    if ((shape.size() != 2) || (shape[1] != dimensions()))
+      throw std::runtime_error("<AtomicDense> indices have wrong shape");
+
+    std::vector<uint32_t> didx(shape[0] * shape[1]);
+    idx.read(didx);
+    std::vector<uint64_t> dcts(shape[0]);
+    cts.read(dcts);
+
+    clear();
+    Coords c(dimensions());
+    for (size_t i = 0; i < dcts.size(); ++i)
+    {
+      for (size_t d = 0; d < c.size(); ++d)
+        c[d] = didx[i * c.size() + d];
+      add({c, dcts[i]});
+    }
+  }
+  catch (...)
+  {
+    std::throw_with_nested(std::runtime_error("<AtomicDense> Could not load"));
+  }
+}
+
+std::string AtomicDense::data_debug(const std::string& prepend) const
+{
+  std::stringstream ss;
+  ss << prepend << "capacity=";
+  for (const auto& c : capacity_)
+    ss << c << " ";
+  ss << "limits=";
+  for (const auto& l : limits())
+    ss << l << " ";
+  ss << "total=" << total_count_ << "\n";
+  return ss.str();
+}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <core/dataspace.h>
+#include <atomic>
+#include <memory>
+
+namespace DAQuiri
+{
+
+//Dense N-dimensional histogram of integer counters. Cells are atomics, so
+//within the reserved extent add_concurrent() can be called from any number
+//of threads without the consumer lock, and readers see each cell either
+//before or after any given increment. Anything that may reallocate
+//(reserve, add_one/add outside the extent, clear, load) still needs
+//exclusive access.
+class AtomicDense : public Dataspace
+{
+  public:
+    AtomicDense(uint16_t dimensions = 1);
+    AtomicDense(const AtomicDense& other);
+    AtomicDense& operator=(const AtomicDense&) = delete;
+    AtomicDense* clone() const override
+    { return new AtomicDense(*this); }
+
+    bool empty() const override;
+    void reserve(const Coords&) override;
+    void clear() override;
+    void add(const Entry&) override;
+    void add_one(const Coords&) override;
+    PreciseFloat get(const Coords&) const override;
+    EntryList range(std::vector<Pair> list) const override;
+    EntryList range_binned(std::vector<Pair> list,
+                           const Coords& resolution) const override;
+    void recalc_axes() override;
+
+    void export_csv(std::ostream&) const override;
+
+    //thread safe, false if coords lie outside the reserved extent. Only
+    //the cell is written, shared state only when it changes; total_count()
+    //is left alone, see count_concurrent()
+    inline bool add_concurrent(const Coords& coords, uint64_t count = 1)
+    {
+      if ((coords.size() != dimensions()) || !fits(coords))
+        return false;
+      counts_[index(coords)].fetch_add(count, std::memory_order_relaxed);
+      for (size_t i = 0; i < coords.size(); ++i)
+      {
+        auto l = limits_[i].load(std::memory_order_relaxed);
+        while ((coords[i] > l) &&
+            !limits_[i].compare_exchange_weak(l, coords[i], std::memory_order_relaxed));
+      }
+      if (!used_.load(std::memory_order_relaxed))
+        used_.store(true, std::memory_order_relaxed);
+      return true;
+    }
+
+    //adds what the threads calling add_concurrent() tallied to the total,
+    //once they are done
+    void count_concurrent(uint64_t count) { total_count_ += count; }
+
+    Coords capacity() const { return capacity_; }
+
+    //largest table, in bytes, that reserve() will allocate ahead of the
+    //data; beyond it growth is also no longer rounded up
+    size_t reserve_budget {size_t(256) << 20};
+
+  protected:
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+    size_t size_ {0};
+    Coords capacity_;
+
+    //largest bin seen per dimension
+    std::unique_ptr<std::atomic<size_t>[]> limits_;
+    std::atomic<bool> used_ {false};
+
+    inline size_t index(const Coords& coords) const
+    {
+      return offset(coords, capacity_);
+    }
+
+    static inline size_t offset(const Coords& coords, const Coords& capacity)
+    {
+      size_t idx = coords[0];
+      for (size_t i = 1; i < coords.size(); ++i)
+        idx = idx * capacity[i] + coords[i];
+      return idx;
+    }
+
+    inline bool fits(const Coords& coords) const
+    {
+      for (size_t i = 0; i < coords.size(); ++i)
+        if (coords[i] >= capacity_[i])
+          return false;
+      return true;
+    }
+
+    Coords limits() const;
+    void grow(const Coords& new_capacity);
+
+    void data_save(const hdf5::node::Group&) const override;
+    void data_load(const hdf5::node::Group&) override;
+    std::string data_debug(const std::string& prepend) const override;
+};
+
+}
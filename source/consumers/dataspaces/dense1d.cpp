@@ -51,11 +51,52 @@ void Dense1D::add_one(const Coords& coords)
   maxchan_ = std::max(maxchan_, bin);
 }
 
+void Dense1D::add_trace(const uint32_t* trace, size_t size,
+                        uint16_t downsample)
+{
+  if (!size)
+    return;
+
+  //sum each group of 2^downsample bins as integers, then touch
+  //the wide-precision spectrum once per output bin
+  size_t group = size_t(1) << downsample;
+  size_t out_size = ((size - 1) >> downsample) + 1;
+  sums_.assign(out_size, 0);
+  if (!downsample)
+    std::copy(trace, trace + size, sums_.begin());
+  else
+    for (size_t i = 0, o = 0; i < size; i += group, ++o)
+    {
+      size_t end = std::min(i + group, size);
+      uint64_t sum{0};
+      for (size_t j = i; j < end; ++j)
+        sum += trace[j];
+      sums_[o] = sum;
+    }
+
+  size_t last = out_size;
+  while (last && !sums_[last - 1])
+    --last;
+  if (!last)
+    return;
+  if (last > spectrum_.size())
+    spectrum_.resize(last, PreciseFloat(0));
+
+  uint64_t total{0};
+  for (size_t o = 0; o < last; ++o)
+  {
+    if (!sums_[o])
+      continue;
+    spectrum_[o] += sums_[o];
+    total += sums_[o];
+  }
+  total_count_ += total;
+  maxchan_ = std::max(maxchan_, last - 1);
+}
+
 void Dense1D::recalc_axes()
 {
-  auto ax = axis(0);
-  ax.expand_domain(maxchan_);
-  set_axis(0, ax);
+  fit_axis(0, maxchan_);
 }
 
 PreciseFloat Dense1D::get(const Coords& coords) const
@@ -17,6 +17,8 @@ class Dense1D : public Dataspace
     void clear() override;
     void add(const Entry&) override;
     void add_one(const Coords&) override;
+    void add_trace(const uint32_t* trace, size_t size,
+                   uint16_t downsample = 0) override;
     PreciseFloat get(const Coords&) const override;
     EntryList range(std::vector<Pair> list) const override;
     void recalc_axes() override;
@@ -28,6 +30,9 @@ class Dense1D : public Dataspace
     std::vector<PreciseFloat> spectrum_;
     size_t maxchan_ {0};
 
+    //scratch for add_trace, kept to avoid reallocating per event
+    std::vector<uint64_t> sums_;
+
     std::string data_debug(const std::string& prepend) const override;
     void data_save(const hdf5::node::Group&) const override;
     void data_load(const hdf5::node::Group&) override;
@@ -44,13 +44,8 @@ void DenseMatrix2D::add_one(const Coords& coords)
 
 void DenseMatrix2D::recalc_axes()
 {
-  auto ax0 = axis(0);
-  ax0.expand_domain(limits_[0]);
-  set_axis(0, ax0);
-
-  auto ax1 = axis(1);
-  ax1.expand_domain(limits_[1]);
-  set_axis(1, ax1);
+  fit_axis(0, limits_[0]);
+  fit_axis(1, limits_[1]);
 }
 
 PreciseFloat DenseMatrix2D::get(const Coords&  coords) const
@@ -87,6 +82,37 @@ EntryList DenseMatrix2D::range(std::vector<Pair> list) const
   return result;
 }
 
+EntryList DenseMatrix2D::range_binned(std::vector<Pair> list,
+                                      const Coords& resolution) const
+{
+  if (list.size() != dimensions())
+    list = {{0, limits_[0]}, {0, limits_[1]}};
+
+  auto factors = binning_factors(list, resolution);
+  if ((factors[0] == 1) && (factors[1] == 1))
+    return range_unbinned(list);
+
+  TileBuffer tiles(list, factors);
+  if (!tiles.valid())
+    return range(list);
+
+  if (!spectrum_.size())
+    return tiles.entries();
+
+  //sum cells straight into tiles, column by column as they are stored
+  size_t max0 = std::min(tiles.maxs()[0], size_t(spectrum_.rows() - 1));
+  size_t max1 = std::min(tiles.maxs()[1], size_t(spectrum_.cols() - 1));
+  Coords bin(2);
+  for (bin[1] = tiles.mins()[1]; bin[1] <= max1; ++bin[1])
+    for (bin[0] = tiles.mins()[0]; bin[0] <= max0; ++bin[0])
+    {
+      auto v = spectrum_.coeff(bin[0], bin[1]);
+      if (v)
+        tiles.add(bin, v);
+    }
+  return tiles.entries();
+}
+
 void DenseMatrix2D::fill_list(EntryList& result,
                          size_t min0, size_t max0,
                          size_t min1, size_t max1) const
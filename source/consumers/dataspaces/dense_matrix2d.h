@@ -26,6 +26,8 @@ class DenseMatrix2D : public Dataspace
     void add_one(const Coords&) override;
     PreciseFloat get(const Coords&) const override;
     EntryList range(std::vector<Pair> list) const override;
+    EntryList range_binned(std::vector<Pair> list,
+                           const Coords& resolution) const override;
     void recalc_axes() override;
 
     void export_csv(std::ostream &) const override {} //TODO: implement
@@ -0,0 +1,426 @@
+#include <consumers/dataspaces/mapped_dense.h>
+#include <core/util/ascii_tree.h>
+#include <core/util/h5json.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace DAQuiri {
+
+namespace {
+
+int open_scratch()
+{
+  const char* dir = std::getenv("TMPDIR");
+  std::string path = std::string(dir ? dir : "/tmp") + "/daquiri-XXXXXX";
+  std::vector<char> name(path.begin(), path.end());
+  name.push_back('\0');
+  int fd = ::mkstemp(name.data());
+  if (fd < 0)
+    throw std::runtime_error("<MappedDense> Could not create scratch file "
+                                 + path + ": " + std::strerror(errno));
+  ::unlink(name.data());
+  return fd;
+}
+
+size_t round_to_pages(size_t bytes)
+{
+  static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return ((bytes + page - 1) / page) * page;
+}
+
+size_t next_pow2(size_t n)
+{
+  size_t ret{1};
+  while (ret < n)
+    ret <<= 1;
+  return ret;
+}
+
+//advances all but the last (contiguous) coordinate, false when done
+bool next_row(Coords& c, const Coords& mins, const Coords& maxs)
+{
+  for (size_t d = c.size() - 1; d > 0; --d)
+  {
+    if (c[d - 1] < maxs[d - 1])
+    {
+      ++c[d - 1];
+      return true;
+    }
+    c[d - 1] = mins[d - 1];
+  }
+  return false;
+}
+
+}
+
+MappedDense::MappedDense(uint16_t dimensions)
+    : Dataspace(dimensions)
+    , capacity_(dimensions, 0)
+    , limits_(dimensions, 0)
+{
+  fd_ = open_scratch();
+}
+
+MappedDense::MappedDense(const MappedDense& other)
+    : Dataspace(other)
+    , capacity_(other.capacity_)
+    , limits_(other.limits_)
+{
+  fd_ = open_scratch();
+  if (!other.counts_)
+    return;
+
+  //copy only the rows in use, the rest of the file stays sparse
+  size_t rows = other.mapped_bytes_ / (row_size() * sizeof(double));
+  remap(rows);
+  if (other.empty())
+    return;
+  size_t used = (limits_[0] + 1) * row_size() * sizeof(double);
+  const char* src = reinterpret_cast<const char*>(other.counts_);
+  size_t done{0};
+  while (done < used)
+  {
+    auto n = ::pwrite(fd_, src + done, used - done, done);
+    if (n <= 0)
+      throw std::runtime_error("<MappedDense> Could not copy scratch file: "
+                                   + std::string(std::strerror(errno)));
+    done += static_cast<size_t>(n);
+  }
+}
+
+MappedDense::~MappedDense()
+{
+  unmap();
+  if (fd_ >= 0)
+    ::close(fd_);
+}
+
+size_t MappedDense::row_size() const
+{
+  size_t ret{1};
+  for (size_t i = 1; i < capacity_.size(); ++i)
+    ret *= capacity_[i];
+  return ret;
+}
+
+void MappedDense::unmap()
+{
+  if (counts_)
+    ::munmap(counts_, mapped_bytes_);
+  counts_ = nullptr;
+  mapped_bytes_ = 0;
+}
+
+void MappedDense::remap(size_t rows)
+{
+  size_t row_bytes = row_size() * sizeof(double);
+  size_t bytes = round_to_pages(rows * row_bytes);
+  if (counts_ && (bytes == mapped_bytes_))
+    return;
+
+  unmap();
+  if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
+    throw std::runtime_error("<MappedDense> Could not resize scratch file: "
+                                 + std::string(std::strerror(errno)));
+  capacity_[0] = row_bytes ? (bytes / row_bytes) : 0;
+  if (!bytes)
+    return;
+
+  void* ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (ptr == MAP_FAILED)
+    throw std::runtime_error("<MappedDense> Could not map "
+                                 + std::to_string(bytes) + " bytes: "
+                                 + std::strerror(errno));
+  counts_ = static_cast<double*>(ptr);
+  mapped_bytes_ = bytes;
+}
+
+void MappedDense::relayout(const Coords& new_capacity)
+{
+  if (!counts_)
+  {
+    for (size_t i = 1; i < capacity_.size(); ++i)
+      capacity_[i] = new_capacity[i];
+    return;
+  }
+
+  MappedDense target(dimensions());
+  target.capacity_ = new_capacity;
+  target.remap(capacity_[0]);
+
+  if (!empty())
+  {
+    Coords mins(dimensions(), 0);
+    Coords c = mins;
+    size_t run = (limits_.back() + 1) * sizeof(double);
+    do
+    {
+      std::memcpy(target.counts_ + target.index(c), counts_ + index(c), run);
+    }
+    while (next_row(c, mins, limits_));
+  }
+
+  unmap();
+  ::close(fd_);
+  fd_ = target.fd_;
+  counts_ = target.counts_;
+  mapped_bytes_ = target.mapped_bytes_;
+  capacity_ = target.capacity_;
+  target.fd_ = -1;
+  target.counts_ = nullptr;
+  target.mapped_bytes_ = 0;
+}
+
+void MappedDense::grow(const Coords& coords)
+{
+  Coords cap = capacity_;
+  bool inner {false};
+  for (size_t i = 1; i < coords.size(); ++i)
+  {
+    if (coords[i] < cap[i])
+      continue;
+    cap[i] = next_pow2(coords[i] + 1);
+    inner = true;
+  }
+  if (inner)
+    relayout(cap);
+
+  if (coords[0] >= capacity_[0])
+    remap(std::max(coords[0] + 1, capacity_[0] * 2));
+}
+
+bool MappedDense::empty() const
+{
+  return (total_count_ == 0);
+}
+
+void MappedDense::reserve(const Coords& limits)
+{
+  if (limits.size() != dimensions())
+    return;
+  Coords cap = capacity_;
+  bool inner {false};
+  size_t row_bytes {sizeof(double)};
+  for (size_t i = 1; i < limits.size(); ++i)
+  {
+    if (limits[i] >= cap[i])
+    {
+      cap[i] = limits[i] + 1;
+      inner = true;
+    }
+    row_bytes *= cap[i];
+  }
+
+  //declared extents can be far wider than anything observed; past the
+  //budget, rows grow with the data instead
+  if (inner && (row_bytes <= reserve_budget))
+    relayout(cap);
+}
+
+void MappedDense::clear()
+{
+  total_count_ = 0;
+  limits_.assign(dimensions(), 0);
+
+  //truncating releases all pages, they read back as zeros when remapped
+  size_t rows = capacity_[0];
+  unmap();
+  if (::ftruncate(fd_, 0) != 0)
+    throw std::runtime_error("<MappedDense> Could not clear scratch file: "
+                                 + std::string(std::strerror(errno)));
+  remap(rows);
+}
+
+void MappedDense::add(const Entry& e)
+{
+  if ((e.first.size() != dimensions()) || !e.second)
+    return;
+  adjust_maxima(e.first);
+  counts_[index(e.first)] += to_double(e.second);
+  total_count_ += e.second;
+}
+
+void MappedDense::add_one(const Coords& coords)
+{
+  if (coords.size() != dimensions())
+    return;
+  adjust_maxima(coords);
+  counts_[index(coords)] += 1;
+  total_count_++;
+}
+
+void MappedDense::recalc_axes()
+{
+  for (size_t i = 0; i < limits_.size(); ++i)
+    fit_axis(i, limits_[i]);
+}
+
+PreciseFloat MappedDense::get(const Coords& coords) const
+{
+  if ((coords.size() != dimensions()) || !counts_ || !fits(coords))
+    return 0;
+  return counts_[index(coords)];
+}
+
+EntryList MappedDense::range(std::vector<Pair> list) const
+{
+  EntryList result(new EntryList_t);
+  if (empty() || !counts_)
+    return result;
+
+  Coords mins(dimensions(), 0);
+  Coords maxs = limits_;
+  if (list.size() == dimensions())
+  {
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+      mins[i] = std::min(list[i].first, list[i].second);
+      maxs[i] = std::min(std::max(list[i].first, list[i].second), limits_[i]);
+      if (mins[i] > maxs[i])
+        return result;
+    }
+  }
+
+  Coords c = mins;
+  do
+  {
+    c.back() = mins.back();
+    const double* row = counts_ + index(c);
+    for (size_t k = 0; k <= (maxs.back() - mins.back()); ++k)
+    {
+      if (!row[k])
+        continue;
+      c.back() = mins.back() + k;
+      result->push_back({c, row[k]});
+    }
+    c.back() = mins.back();
+  }
+  while (next_row(c, mins, maxs));
+
+  return result;
+}
+
+void MappedDense::export_csv(std::ostream& os) const
+{
+  for (const auto& e : *range({}))
+  {
+    for (const auto& c : e.first)
+      os << c << ", ";
+    os << e.second << ";\n";
+  }
+}
+
+void MappedDense::data_save(const hdf5::node::Group& g) const
+{
+  if (empty() || !counts_)
+    return;
+
+  try
+  {
+    using namespace hdf5;
+
+    Dimensions shape;
+    for (const auto& l : limits_)
+      shape.push_back(l + 1);
+    Dimensions capacity(capacity_.begin(), capacity_.end());
+    Dimensions start(dimensions(), 0);
+
+    auto dcts = g.create_dataset("counts", datatype::create<double>(),
+                                 dataspace::Simple(shape));
+
+    //mapped buffer goes straight to the file, selecting the used region
+    hid_t mem_space = H5Screate_simple(static_cast<int>(dimensions()),
+                                       capacity.data(), nullptr);
+    H5Sselect_hyperslab(mem_space, H5S_SELECT_SET, start.data(), nullptr,
+                        shape.data(), nullptr);
+    herr_t err = H5Dwrite(static_cast<hid_t>(dcts), H5T_NATIVE_DOUBLE,
+                          mem_space, H5S_ALL, H5P_DEFAULT, counts_);
+    H5Sclose(mem_space);
+    if (err < 0)
+      throw std::runtime_error("<MappedDense> H5Dwrite failed");
+  }
+  catch (...)
+  {
+    std::throw_with_nested(std::runtime_error("<MappedDense> Could not save"));
+  }
+}
+
+void MappedDense::data_load(const hdf5::node::Group& g)
+{
+  try
+  {
+    using namespace hdf5;
+
+    if (!g.has_dataset("counts"))
+      return;
+
+    auto dcts = hdf5::node::Group(g).get_dataset("counts");
+    auto shape = dataspace::Simple(dcts.dataspace()).current_dimensions();
+    if (shape.size() != dimensions())
+      throw std::runtime_error("<MappedDense> dataset has wrong rank");
+
+    clear();
+    Coords limits;
+    for (const auto& s : shape)
+    {
+      if (!s)
+        return;
+      limits.push_back(s - 1);
+    }
+    //lay out the saved shape exactly, regardless of reserve_budget
+    Coords cap = capacity_;
+    for (size_t i = 1; i < limits.size(); ++i)
+      cap[i] = std::max(cap[i], limits[i] + 1);
+    if (cap != capacity_)
+      relayout(cap);
+    if (limits[0] >= capacity_[0])
+      remap(limits[0] + 1);
+
+    Dimensions capacity(capacity_.begin(), capacity_.end());
+    Dimensions start(dimensions(), 0);
+    hid_t mem_space = H5Screate_simple(static_cast<int>(dimensions()),
+                                       capacity.data(), nullptr);
+    H5Sselect_hyperslab(mem_space, H5S_SELECT_SET, start.data(), nullptr,
+                        shape.data(), nullptr);
+    herr_t err = H5Dread(static_cast<hid_t>(dcts), H5T_NATIVE_DOUBLE,
+                         mem_space, H5S_ALL, H5P_DEFAULT, counts_);
+    H5Sclose(mem_space);
+    if (err < 0)
+      throw std::runtime_error("<MappedDense> H5Dread failed");
+
+    limits_ = limits;
+    Coords mins(dimensions(), 0);
+    Coords c = mins;
+    do
+    {
+      const double* row = counts_ + index(c);
+      for (size_t k = 0; k <= limits_.back(); ++k)
+        total_count_ += row[k];
+    }
+    while (next_row(c, mins, limits_));
+  }
+  catch (...)
+  {
+    std::throw_with_nested(std::runtime_error("<MappedDense> Could not load"));
+  }
+}
+
+std::string MappedDense::data_debug(const std::string& prepend) const
+{
+  std::stringstream ss;
+  ss << prepend << "capacity=";
+  for (const auto& c : capacity_)
+    ss << c << " ";
+  ss << "limits=";
+  for (const auto& l : limits_)
+    ss << l << " ";
+  ss << "mapped=" << mapped_bytes_ << "B\n";
+  return ss.str();
+}
+
+}
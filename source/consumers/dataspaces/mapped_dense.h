@@ -0,0 +1,87 @@
+#pragma once
+
+#include <core/dataspace.h>
+
+namespace DAQuiri
+{
+
+//Dense N-dimensional histogram kept in a memory-mapped scratch file.
+//Counts are doubles in row-major order over the reserved capacity, so
+//resident memory is bounded by the pages actually touched and the
+//buffer can be handed to HDF5 as-is. Growing the outermost dimension
+//only extends the file, growing inner dimensions relayouts it, so
+//reserve() the expected extents before binning. Rows along the outermost
+//dimension are never reserved up front, they are mapped as they are hit.
+class MappedDense : public Dataspace
+{
+  public:
+    MappedDense(uint16_t dimensions = 3);
+    MappedDense(const MappedDense& other);
+    MappedDense& operator=(const MappedDense&) = delete;
+    ~MappedDense();
+    MappedDense* clone() const override
+    { return new MappedDense(*this); }
+
+    bool empty() const override;
+    void reserve(const Coords&) override;
+    void clear() override;
+    void add(const Entry&) override;
+    void add_one(const Coords&) override;
+    PreciseFloat get(const Coords&) const override;
+    EntryList range(std::vector<Pair> list) const override;
+    void recalc_axes() override;
+
+    void export_csv(std::ostream&) const override;
+
+    //bytes of scratch file currently mapped
+    size_t mapped_bytes() const { return mapped_bytes_; }
+
+    //largest row, in bytes, that reserve() will lay out ahead of the data
+    size_t reserve_budget {size_t(16) << 20};
+
+  protected:
+    //scratch file, unlinked as soon as it is created
+    int fd_ {-1};
+    double* counts_ {nullptr};
+    size_t mapped_bytes_ {0};
+
+    //allocated extent and largest bin seen, per dimension
+    Coords capacity_;
+    Coords limits_;
+
+    inline size_t index(const Coords& coords) const
+    {
+      size_t idx = coords[0];
+      for (size_t i = 1; i < coords.size(); ++i)
+        idx = idx * capacity_[i] + coords[i];
+      return idx;
+    }
+
+    inline bool fits(const Coords& coords) const
+    {
+      for (size_t i = 0; i < coords.size(); ++i)
+        if (coords[i] >= capacity_[i])
+          return false;
+      return true;
+    }
+
+    inline void adjust_maxima(const Coords& coords)
+    {
+      if (!fits(coords))
+        grow(coords);
+      for (size_t i = 0; i < coords.size(); ++i)
+        limits_[i] = std::max(limits_[i], coords[i]);
+    }
+
+    void grow(const Coords& coords);
+    void remap(size_t rows);
+    void relayout(const Coords& new_capacity);
+    void unmap();
+    size_t row_size() const;
+
+    void data_save(const hdf5::node::Group&) const override;
+    void data_load(const hdf5::node::Group&) override;
+    std::string data_debug(const std::string& prepend) const override;
+};
+
+}
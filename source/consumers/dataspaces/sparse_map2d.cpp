@@ -38,13 +38,8 @@ void SparseMap2D::add_one(const Coords& coords)
 
 void SparseMap2D::recalc_axes()
 {
-  auto ax0 = axis(0);
-  ax0.expand_domain(max0_);
-  set_axis(0, ax0);
-
-  auto ax1 = axis(1);
-  ax1.expand_domain(max1_);
-  set_axis(1, ax1);
+  fit_axis(0, max0_);
+  fit_axis(1, max1_);
 }
 
 PreciseFloat SparseMap2D::get(const Coords& coords) const
@@ -86,6 +81,36 @@ EntryList SparseMap2D::range(std::vector<Pair> list) const
   return result;
 }
 
+EntryList SparseMap2D::range_binned(std::vector<Pair> list,
+                                    const Coords& resolution) const
+{
+  if (list.size() != dimensions())
+    list = {{0, max0_}, {0, max1_}};
+
+  auto factors = binning_factors(list, resolution);
+  if ((factors[0] == 1) && (factors[1] == 1))
+    return range_unbinned(list);
+
+  TileBuffer tiles(list, factors);
+  if (!tiles.valid())
+    return range(list);
+
+  //sum entries straight into tiles, skipping those outside range
+  const auto& mins = tiles.mins();
+  const auto& maxs = tiles.maxs();
+  Coords bin(2);
+  for (const auto& it : spectrum_)
+  {
+    bin[0] = it.first.first;
+    bin[1] = it.first.second;
+    if ((mins[0] > bin[0]) || (bin[0] > maxs[0]) ||
+        (mins[1] > bin[1]) || (bin[1] > maxs[1]))
+      continue;
+    tiles.add(bin, it.second);
+  }
+  return tiles.entries();
+}
+
 void SparseMap2D::fill_list(EntryList& result,
                           size_t min0, size_t max0,
                           size_t min1, size_t max1) const
@@ -39,17 +39,9 @@ void SparseMap3D::add_one(const Coords& coords)
 
 void SparseMap3D::recalc_axes()
 {
-  auto ax0 = axis(0);
-  ax0.expand_domain(max0_);
-  set_axis(0, ax0);
-
-  auto ax1 = axis(1);
-  ax1.expand_domain(max1_);
-  set_axis(1, ax1);
-
-  auto ax2 = axis(2);
-  ax2.expand_domain(max2_);
-  set_axis(2, ax2);
+  fit_axis(0, max0_);
+  fit_axis(1, max1_);
+  fit_axis(2, max2_);
 }
 
 PreciseFloat SparseMap3D::get(const Coords& coords) const
@@ -44,13 +44,8 @@ void SparseMatrix2D::add_one(const Coords& coords)
 
 void SparseMatrix2D::recalc_axes()
 {
-  auto ax0 = axis(0);
-  ax0.expand_domain(limits_[0]);
-  set_axis(0, ax0);
-
-  auto ax1 = axis(1);
-  ax1.expand_domain(limits_[1]);
-  set_axis(1, ax1);
+  fit_axis(0, limits_[0]);
+  fit_axis(1, limits_[1]);
 }
 
 PreciseFloat SparseMatrix2D::get(const Coords& coords) const
@@ -89,6 +84,61 @@ EntryList SparseMatrix2D::range(std::vector<Pair> list) const
   return result;
 }
 
+EntryList SparseMatrix2D::range_binned(std::vector<Pair> list,
+                                       const Coords& resolution) const
+{
+  if (list.size() != dimensions())
+    list = {{0, limits_[0]}, {0, limits_[1]}};
+
+  int64_t min0 = std::min(list[0].first, list[0].second);
+  int64_t max0 = std::max(list[0].first, list[0].second);
+  int64_t min1 = std::min(list[1].first, list[1].second);
+  int64_t max1 = std::max(list[1].first, list[1].second);
+
+  auto factors = binning_factors(list, resolution);
+  if ((factors[0] == 1) && (factors[1] == 1))
+  {
+    //tiles are bins, still relative to range start
+    auto fine = range(list);
+    for (auto& e : *fine)
+    {
+      e.first[0] -= min0;
+      e.first[1] -= min1;
+    }
+    return fine;
+  }
+
+  int64_t f0 = factors[0];
+  int64_t f1 = factors[1];
+  int64_t tiles0 = (max0 - min0) / f0 + 1;
+  int64_t tiles1 = (max1 - min1) / f1 + 1;
+
+  //sum non-zeros straight into tiles, skipping columns outside range
+  std::vector<double> tiles(tiles0 * tiles1, 0.0);
+  for (int64_t k = min1; (k <= max1) && (k < spectrum_.outerSize()); ++k)
+  {
+    int64_t t1 = (k - min1) / f1;
+    for (data_type_t::InnerIterator it(spectrum_, k); it; ++it)
+    {
+      const auto& co0 = it.row();
+      if ((min0 > co0) || (co0 > max0))
+        continue;
+      tiles[((co0 - min0) / f0) * tiles1 + t1] += it.value();
+    }
+  }
+
+  EntryList result(new EntryList_t);
+  for (int64_t t0 = 0; t0 < tiles0; ++t0)
+    for (int64_t t1 = 0; t1 < tiles1; ++t1)
+    {
+      const auto& v = tiles[t0 * tiles1 + t1];
+      if (v)
+        result->push_back({{static_cast<unsigned long>(t0),
+                            static_cast<unsigned long>(t1)}, v});
+    }
+  return result;
+}
+
 void SparseMatrix2D::fill_list(EntryList& result,
                                int64_t min0, int64_t max0,
                                int64_t min1, int64_t max1) const
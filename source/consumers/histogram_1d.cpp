@@ -34,12 +34,16 @@ void Histogram1D::_apply_attributes()
 
 void Histogram1D::_recalc_axes()
 {
-  Detector det;
-  if (data_->dimensions() == metadata_.detectors.size())
-    det = metadata_.detectors[0];
+  if (axes_stale_)
+  {
+    Detector det;
+    if (data_->dimensions() == metadata_.detectors.size())
+      det = metadata_.detectors[0];
 
-  auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
-  data_->set_axis(0, DataAxis(calib, value_latch_.downsample));
+    auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
+    data_->define_axis(0, DataAxis(calib, value_latch_.downsample));
+    axes_stale_ = false;
+  }
 
   data_->recalc_axes();
 }
@@ -63,6 +67,30 @@ bool Histogram1D::_accept_events(const Spill& /*spill*/)
   return value_latch_.valid();
 }
 
+void Histogram1D::_push_events(const Spill& spill, size_t begin, size_t end)
+{
+  //bins shared with other histograms of the same value and downsampling
+  auto bins = value_latch_.column(cache_, spill, end);
+  if (!bins)
+  {
+    Spectrum::_push_events(spill, begin, end);
+    return;
+  }
+
+  auto mask = filters_.mask(cache_, spill, end);
+  for (size_t i = begin; i < end; ++i)
+  {
+    if (mask && !mask[i])
+    {
+      profile_.events_rejected++;
+      continue;
+    }
+    profile_.events_accepted++;
+    coords_[0] = bins[i];
+    data_->add_one(coords_);
+  }
+}
+
 void Histogram1D::_push_event(const Event& event)
 {
   if (!filters_.accept(event))
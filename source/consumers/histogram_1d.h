@@ -18,6 +18,7 @@ class Histogram1D : public Spectrum
     void _recalc_axes() override;
 
     //event processing
+    void _push_events(const Spill& spill, size_t begin, size_t end) override;
     void _push_event(const Event& event) override;
     void _push_stats_pre(const Spill& spill) override;
     bool _accept_spill(const Spill& spill) override;
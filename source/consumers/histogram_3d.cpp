@@ -1,6 +1,7 @@
 #include <consumers/histogram_3d.h>
 
 #include <consumers/dataspaces/sparse_map3d.h>
+#include <consumers/dataspaces/mapped_dense.h>
 //#include <consumers/dataspaces/sparse_matrix3d.h>
 //#include <consumers/dataspaces/dense_matrix3d.h>
 
@@ -21,6 +22,11 @@ Histogram3D::Histogram3D()
   base_options.branches.add_a(value_latch_x_.settings(0, "X value"));
   base_options.branches.add_a(value_latch_y_.settings(1, "Y value"));
   base_options.branches.add_a(value_latch_z_.settings(2, "Z value"));
+  base_options.branches.add(shards_.settings());
+
+  SettingMeta dense("dense", SettingType::boolean, "Dense memory-mapped storage");
+  dense.set_flag("preset");
+  base_options.branches.add(dense);
 
   metadata_.overwrite_all_attributes(base_options);
 }
@@ -37,27 +43,55 @@ void Histogram3D::_apply_attributes()
 
   value_latch_z_.settings(metadata_.get_attribute(value_latch_z_.settings(2, "Z value")));
   metadata_.replace_attribute(value_latch_z_.settings(2, "Z value"));
+
+  //partials belong to the current dataspace and shard count
+  shards_.merge(data_);
+  shards_.settings(metadata_.get_attribute("sharding"));
+
+  bool dense = metadata_.get_attribute("dense").get_bool();
+  if (dense != dense_)
+  {
+    DataspacePtr replacement;
+    if (dense)
+      replacement = std::make_shared<MappedDense>(3);
+    else
+      replacement = std::make_shared<SparseMap3D>();
+    if (data_)
+    {
+      auto entries = data_->range({});
+      for (const auto& e : *entries)
+        replacement->add(e);
+    }
+    data_ = replacement;
+    dense_ = dense;
+    axes_stale_ = true;
+    reserved_.clear();
+  }
 }
 
 void Histogram3D::_recalc_axes()
 {
-  Detector det0, det1, det2;
-  if (data_->dimensions() == metadata_.detectors.size())
+  if (axes_stale_)
   {
-    det0 = metadata_.detectors[0];
-    det1 = metadata_.detectors[1];
-    det2 = metadata_.detectors[2];
+    Detector det0, det1, det2;
+    if (data_->dimensions() == metadata_.detectors.size())
+    {
+      det0 = metadata_.detectors[0];
+      det1 = metadata_.detectors[1];
+      det2 = metadata_.detectors[2];
+    }
+
+    auto calib0 = det0.get_calibration({value_latch_x_.value_id, det0.id()}, {value_latch_x_.value_id});
+    data_->define_axis(0, DataAxis(calib0, value_latch_x_.downsample));
+
+    auto calib1 = det1.get_calibration({value_latch_y_.value_id, det1.id()}, {value_latch_y_.value_id});
+    data_->define_axis(1, DataAxis(calib1, value_latch_y_.downsample));
+
+    auto calib2 = det2.get_calibration({value_latch_z_.value_id, det2.id()}, {value_latch_z_.value_id});
+    data_->define_axis(2, DataAxis(calib2, value_latch_z_.downsample));
+    axes_stale_ = false;
   }
 
-  auto calib0 = det0.get_calibration({value_latch_x_.value_id, det0.id()}, {value_latch_x_.value_id});
-  data_->set_axis(0, DataAxis(calib0, value_latch_x_.downsample));
-
-  auto calib1 = det1.get_calibration({value_latch_y_.value_id, det1.id()}, {value_latch_y_.value_id});
-  data_->set_axis(1, DataAxis(calib1, value_latch_y_.downsample));
-
-  auto calib2 = det2.get_calibration({value_latch_z_.value_id, det2.id()}, {value_latch_z_.value_id});
-  data_->set_axis(2, DataAxis(calib2, value_latch_z_.downsample));
-
   data_->recalc_axes();
 }
 
@@ -77,14 +111,51 @@ void Histogram3D::_push_stats_pre(const Spill& spill)
   value_latch_x_.configure(spill);
   value_latch_y_.configure(spill);
   value_latch_z_.configure(spill);
+  if (_accept_events(spill))
+  {
+    Coords maxima {value_latch_x_.max_bin(spill),
+                   value_latch_y_.max_bin(spill),
+                   value_latch_z_.max_bin(spill)};
+    if (maxima != reserved_)
+    {
+      data_->reserve(maxima);
+      reserved_ = maxima;
+    }
+  }
   Spectrum::_push_stats_pre(spill);
 }
 
+void Histogram3D::_push_stats_post(const Spill& spill)
+{
+  shards_.merge(data_);
+  Spectrum::_push_stats_post(spill);
+}
+
 bool Histogram3D::_accept_events(const Spill& /*spill*/)
 {
   return value_latch_x_.valid() && value_latch_y_.valid() && value_latch_z_.valid();
 }
 
+void Histogram3D::_push_events(const Spill& spill, size_t begin, size_t end)
+{
+  if (!shards_.parallel(end - begin, *data_))
+  {
+    Spectrum::_push_events(spill, begin, end);
+    return;
+  }
+  auto accepted =
+      shards_.bin(spill.events.begin() + begin, spill.events.begin() + end,
+                  data_, filters_, 3,
+                  [this](const Event& event, Coords& coords)
+                  {
+                    value_latch_x_.extract(coords[0], event);
+                    value_latch_y_.extract(coords[1], event);
+                    value_latch_z_.extract(coords[2], event);
+                  });
+  profile_.events_accepted += accepted;
+  profile_.events_rejected += (end - begin) - accepted;
+}
+
 void Histogram3D::_push_event(const Event& event)
 {
   if (!filters_.accept(event))
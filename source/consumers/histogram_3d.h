@@ -2,6 +2,7 @@
 
 #include <consumers/spectrum.h>
 #include <consumers/add_ons/value_latch.h>
+#include <consumers/add_ons/shards.h>
 
 namespace DAQuiri {
 
@@ -17,8 +18,10 @@ class Histogram3D : public Spectrum
     void _apply_attributes() override;
     void _recalc_axes() override;
 
+    void _push_events(const Spill& spill, size_t begin, size_t end) override;
     void _push_event(const Event&) override;
     void _push_stats_pre(const Spill& spill) override;
+    void _push_stats_post(const Spill& spill) override;
 
     bool _accept_spill(const Spill& spill) override;
     bool _accept_events(const Spill& spill) override;
@@ -27,9 +30,16 @@ class Histogram3D : public Spectrum
     ValueLatch value_latch_x_;
     ValueLatch value_latch_y_;
     ValueLatch value_latch_z_;
+    Shards shards_;
 
     //reserve memory
     Coords coords_{0, 0, 0};
+
+    //backed by MappedDense rather than SparseMap3D
+    bool dense_ {false};
+
+    //declared maxima last reserved for, to do it once per event model
+    Coords reserved_;
 };
 
 }
@@ -46,19 +46,23 @@ void Image2D::_apply_attributes()
 
 void Image2D::_recalc_axes()
 {
-  Detector det0, det1;
-  if (data_->dimensions() == metadata_.detectors.size())
+  if (axes_stale_)
   {
-    det0 = metadata_.detectors[0];
-    det1 = metadata_.detectors[1];
+    Detector det0, det1;
+    if (data_->dimensions() == metadata_.detectors.size())
+    {
+      det0 = metadata_.detectors[0];
+      det1 = metadata_.detectors[1];
+    }
+
+    auto calib0 = det0.get_calibration({value_latch_x_.value_id, det0.id()}, {value_latch_x_.value_id});
+    data_->define_axis(0, DataAxis(calib0, value_latch_x_.downsample));
+
+    auto calib1 = det1.get_calibration({value_latch_y_.value_id, det1.id()}, {value_latch_y_.value_id});
+    data_->define_axis(1, DataAxis(calib1, value_latch_y_.downsample));
+    axes_stale_ = false;
   }
 
-  auto calib0 = det0.get_calibration({value_latch_x_.value_id, det0.id()}, {value_latch_x_.value_id});
-  data_->set_axis(0, DataAxis(calib0, value_latch_x_.downsample));
-
-  auto calib1 = det1.get_calibration({value_latch_y_.value_id, det1.id()}, {value_latch_y_.value_id});
-  data_->set_axis(1, DataAxis(calib1, value_latch_y_.downsample));
-
   data_->recalc_axes();
 }
 
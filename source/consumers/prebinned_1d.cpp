@@ -36,19 +36,29 @@ Prebinned1D::Prebinned1D()
 void Prebinned1D::_apply_attributes()
 {
   Spectrum::_apply_attributes();
-  trace_name_ = metadata_.get_attribute("trace_id").get_text();
+  auto trace_name = metadata_.get_attribute("trace_id").get_text();
+  if (trace_name != trace_name_)
+  {
+    trace_idx_ = -1;
+    model_id_ = 0;
+    trace_name_ = trace_name;
+  }
   downsample_ = static_cast<uint16_t>(metadata_.get_attribute("downsample").get_int());
   this->_recalc_axes();
 }
 
 void Prebinned1D::_recalc_axes()
 {
-  Detector det;
-  if (data_->dimensions() == metadata_.detectors.size())
-    det = metadata_.detectors[0];
+  if (axes_stale_)
+  {
+    Detector det;
+    if (data_->dimensions() == metadata_.detectors.size())
+      det = metadata_.detectors[0];
 
-  auto calib = det.get_calibration({trace_name_, det.id()}, {trace_name_});
-  data_->set_axis(0, DataAxis(calib, downsample_));
+    auto calib = det.get_calibration({trace_name_, det.id()}, {trace_name_});
+    data_->define_axis(0, DataAxis(calib, downsample_));
+    axes_stale_ = false;
+  }
 
   data_->recalc_axes();
 }
@@ -57,9 +67,18 @@ void Prebinned1D::_recalc_axes()
 
 bool Prebinned1D::_accept_spill(const Spill& spill)
 {
-  return (Spectrum::_accept_spill(spill)
-      &&
-          spill.event_model.name_to_trace.count(trace_name_));
+  if (!Spectrum::_accept_spill(spill))
+    return false;
+  if (spill.event_model.id() != model_id_)
+  {
+    model_id_ = spill.event_model.id();
+    auto it = spill.event_model->name_to_trace.find(trace_name_);
+    if (it != spill.event_model->name_to_trace.end())
+      trace_idx_ = static_cast<int>(it->second);
+    else
+      trace_idx_ = -1;
+  }
+  return (trace_idx_ >= 0);
 }
 
 bool Prebinned1D::_accept_events(const Spill& /*spill*/)
@@ -70,10 +89,7 @@ bool Prebinned1D::_accept_events(const Spill& /*spill*/)
 void Prebinned1D::_push_stats_pre(const Spill& spill)
 {
   if (this->_accept_spill(spill))
-  {
-    trace_idx_ = spill.event_model.name_to_trace.at(trace_name_);
     Spectrum::_push_stats_pre(spill);
-  }
 }
 
 void Prebinned1D::_push_event(const Event& event)
@@ -82,13 +98,7 @@ void Prebinned1D::_push_event(const Event& event)
     return;
 
   const auto& trace = event.trace(trace_idx_);
-
-  for (size_t i = 0; i < trace.size(); ++i)
-  {
-    entry_.first[0] = (i >> downsample_);
-    entry_.second = trace[i];
-    data_->add(entry_);
-  }
+  data_->add_trace(trace.data(), trace.size(), downsample_);
 }
 
 }
@@ -32,9 +32,8 @@ class Prebinned1D : public Spectrum
 
   //from status manifest
   int trace_idx_{-1};
-
-  //reserve memory
-  Entry entry_{{0}, 0};
+  //event model trace_idx_ was resolved against
+  uint64_t model_id_{0};
 };
 
 }
@@ -1,6 +1,7 @@
 #include <consumers/spectrum.h>
 
 #include <core/util/logger.h>
+#include <map>
 
 namespace DAQuiri {
 
@@ -41,6 +42,13 @@ Spectrum::Spectrum()
 
   base_options.branches.add(periodic_trigger_.settings(-1, "Clear periodically"));
 
+  SettingMeta history("history_frames", SettingType::integer,
+                      "Periods kept instead of cleared");
+  history.set_flag("preset");
+  history.set_val("min", 0);
+  history.set_val("max", 10000);
+  base_options.branches.add(history);
+
   base_options.branches.add(filters_.settings());
 
   metadata_.overwrite_all_attributes(base_options);
@@ -51,12 +59,18 @@ void Spectrum::_apply_attributes()
   try
   {
     Consumer::_apply_attributes();
+    axes_stale_ = true;
 
     filters_.settings(metadata_.get_attribute("filters"));
     metadata_.replace_attribute(filters_.settings());
 
     periodic_trigger_.settings(metadata_.get_attribute(periodic_trigger_.settings()));
     metadata_.replace_attribute(periodic_trigger_.settings(-1, "Clear periodically"));
+
+    history_frames_ = static_cast<size_t>(
+        std::max(integer_t(0), metadata_.get_attribute("history_frames").get_int()));
+    while (history_.size() > history_frames_)
+      history_.pop_front();
   }
   catch (...)
   {
@@ -64,6 +78,12 @@ void Spectrum::_apply_attributes()
   }
 }
 
+void Spectrum::_set_detectors(const std::vector<Detector>& dets)
+{
+  axes_stale_ = true;
+  Consumer::_set_detectors(dets);
+}
+
 bool Spectrum::_accept_spill(const Spill& spill)
 {
   return (Consumer::_accept_spill(spill)
@@ -77,20 +97,125 @@ void Spectrum::_push_stats_pre(const Spill& spill)
 
   filters_.configure(spill);
 
-  if (metadata_.get_attribute("start_time").time() == hr_time_t())
-    metadata_.set_attribute(Setting("start_time", spill.time));
+  auto start_time = metadata_.attribute(start_time_);
+  if (start_time && (start_time->time() == hr_time_t()))
+    start_time->set_time(spill.time);
+
+  if (period_start_ == hr_time_t())
+    period_start_ = spill.time;
 
   if (periodic_trigger_.triggered)
   {
     if (data_)
     {
-      data_->clear();
+      if (history_frames_)
+        seal_period(spill.time);
+      else
+        data_->clear();
       recent_rate_.update(recent_rate_.previous_status, data_->total_count());
     }
+    period_start_ = spill.time;
     periodic_trigger_.triggered = false;
   }
 }
 
+void Spectrum::seal_period(hr_time_t end)
+{
+  history_.push_back({period_start_, end, data_});
+
+  //binning goes on in the oldest frame's storage, unless a copy of this
+  //consumer still shares it
+  DataspacePtr fresh;
+  if (history_.size() > history_frames_)
+  {
+    fresh = history_.front().data;
+    history_.pop_front();
+  }
+  if (!fresh || (fresh.use_count() > 1))
+    fresh = DataspacePtr(data_->clone());
+  fresh->clear();
+  data_ = fresh;
+  axes_stale_ = true;
+}
+
+size_t Spectrum::frames() const
+{
+  SHARED_LOCK_ST
+  return history_.size();
+}
+
+Spectrum::Frame Spectrum::frame(size_t age) const
+{
+  SHARED_LOCK_ST
+  if (age >= history_.size())
+    throw std::runtime_error("<Spectrum> No frame of age " + std::to_string(age));
+  auto ret = history_[history_.size() - 1 - age];
+  ret.data = DataspacePtr(ret.data->clone());
+  return ret;
+}
+
+DataspacePtr Spectrum::frame_sum(size_t count) const
+{
+  SHARED_LOCK_ST
+  if (history_.empty() || !count)
+    return nullptr;
+  count = std::min(count, history_.size());
+  auto newest = history_.rbegin();
+  DataspacePtr ret(newest->data->clone());
+  for (auto f = std::next(newest); f != newest + count; ++f)
+  {
+    auto entries = f->data->range({});
+    for (const auto& e : *entries)
+      ret->add(e);
+  }
+  ret->recalc_axes();
+  return ret;
+}
+
+EntryList Spectrum::frame_diff(size_t newer, size_t older) const
+{
+  SHARED_LOCK_ST
+  if ((newer >= history_.size()) || (older >= history_.size()))
+    throw std::runtime_error("<Spectrum> No frames of ages "
+                                 + std::to_string(newer) + " and " + std::to_string(older));
+
+  //counting backends are unsigned, so differences are not kept in a dataspace
+  std::map<Coords, PreciseFloat> diff;
+  auto added = history_[history_.size() - 1 - newer].data->range({});
+  for (const auto& e : *added)
+    diff[e.first] += e.second;
+  auto subtracted = history_[history_.size() - 1 - older].data->range({});
+  for (const auto& e : *subtracted)
+    diff[e.first] -= e.second;
+
+  auto ret = std::make_shared<EntryList_t>();
+  for (const auto& d : diff)
+    if (d.second != 0)
+      ret->push_back(d);
+  return ret;
+}
+
+void Spectrum::_push_events(const Spill& spill, size_t begin, size_t end)
+{
+  //other consumers with the same filters may have evaluated them already
+  auto mask = filters_.mask(cache_, spill, end);
+
+  filters_.preselected = true;
+  auto first = spill.events.begin();
+  for (size_t i = begin; i < end; ++i)
+  {
+    const auto& event = *(first + i);
+    if (mask ? mask[i] : filters_.passes(event))
+    {
+      profile_.events_accepted++;
+      this->_push_event(event);
+    }
+    else
+      profile_.events_rejected++;
+  }
+  filters_.preselected = false;
+}
+
 void Spectrum::update_cumulative(const Status& new_status)
 {
   if (stats_.size() &&
@@ -102,8 +227,10 @@ void Spectrum::update_cumulative(const Status& new_status)
   auto real_time = Status::total_elapsed(stats_, "native_time");
   if (live_time == hr_duration_t())
     live_time = real_time;
-  metadata_.set_attribute(Setting("live_time", live_time));
-  metadata_.set_attribute(Setting("real_time", real_time));
+  if (auto lt = metadata_.attribute(live_time_))
+    lt->set_duration(live_time);
+  if (auto rt = metadata_.attribute(real_time_))
+    rt->set_duration(real_time);
 }
 
 void Spectrum::_push_stats_post(const Spill& spill)
@@ -119,7 +246,8 @@ void Spectrum::_push_stats_post(const Spill& spill)
 
   if (data_)
   {
-    metadata_.set_attribute(Setting::precise("total_count", data_->total_count()));
+    if (auto tc = metadata_.attribute(total_count_))
+      tc->set_precise(data_->total_count());
     metadata_.set_attribute(recent_rate_.update(new_status, data_->total_count()));
   }
 }
@@ -128,9 +256,10 @@ void Spectrum::_flush()
 {
   if (!data_)
     return;
-  metadata_.set_attribute(Setting::precise("total_count", data_->total_count()));
+  if (auto tc = metadata_.attribute(total_count_))
+    tc->set_precise(data_->total_count());
   metadata_.set_attribute(
       recent_rate_.update(recent_rate_.previous_status, data_->total_count()));
 }
 
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 #include <consumers/add_ons/periodic_trigger.h>
 #include <consumers/add_ons/recent_rate.h>
 #include <consumers/add_ons/filter_block.h>
+#include <deque>
 
 namespace DAQuiri {
 
@@ -12,10 +13,28 @@ class Spectrum : public Consumer
   public:
     Spectrum();
 
+    //histogram of one trigger period, sealed when the next one began
+    struct Frame
+    {
+      hr_time_t start;
+      hr_time_t end;
+      DataspacePtr data;
+    };
+
+    //periods kept instead of cleared, newest is age 0
+    size_t frames() const;
+    Frame frame(size_t age) const;
+    //the newest count periods summed
+    DataspacePtr frame_sum(size_t count) const;
+    //bin by bin newer minus older, may go negative
+    EntryList frame_diff(size_t newer, size_t older) const;
+
   protected:
     void _apply_attributes() override;
+    void _set_detectors(const std::vector<Detector>& dets) override;
     bool _accept_spill(const Spill& spill) override;
     void _push_stats_pre(const Spill& spill) override;
+    void _push_events(const Spill& spill, size_t begin, size_t end) override;
     void _push_stats_post(const Spill& spill) override;
     void _flush() override;
 
@@ -28,6 +47,23 @@ class Spectrum : public Consumer
 
     std::vector<Status> stats_;
 
+    //sealed periods, oldest first; only read, until the oldest is recycled
+    size_t history_frames_ {0};
+    std::deque<Frame> history_;
+    hr_time_t period_start_;
+
+    void seal_period(hr_time_t end);
+
+    //axis definitions need to be rebuilt from detectors and attributes
+    bool axes_stale_ {true};
+
+    //attributes updated with every spill
+    //resolved on first use, so also before attributes are ever applied
+    AttributeHandle start_time_ {"start_time"};
+    AttributeHandle live_time_ {"live_time"};
+    AttributeHandle real_time_ {"real_time"};
+    AttributeHandle total_count_ {"total_count"};
+
     void update_cumulative(const Status&);
 };
 
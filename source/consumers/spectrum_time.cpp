@@ -64,12 +64,16 @@ void TimeSpectrum::_init_from_file()
 
 void TimeSpectrum::_recalc_axes()
 {
-  Detector det;
-  if (metadata_.detectors.size() == 1)
-    det = metadata_.detectors[0];
+  if (axes_stale_)
+  {
+    Detector det;
+    if (metadata_.detectors.size() == 1)
+      det = metadata_.detectors[0];
 
-  auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
-  data_->set_axis(1, DataAxis(calib, value_latch_.downsample));
+    auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
+    data_->define_axis(1, DataAxis(calib, value_latch_.downsample));
+    axes_stale_ = false;
+  }
 
   data_->recalc_axes();
 
@@ -87,7 +91,7 @@ void TimeSpectrum::_push_stats_pre(const Spill& spill)
 {
   if (!this->_accept_spill(spill))
     return;
-  timebase_ = spill.event_model.timebase;
+  timebase_ = spill.event_model->timebase;
   value_latch_.configure(spill);
   Spectrum::_push_stats_pre(spill);
 }
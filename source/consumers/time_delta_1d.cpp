@@ -89,9 +89,11 @@ bool TimeDelta1D::_accept_spill(const Spill& spill)
 
 void TimeDelta1D::_push_stats_pre(const Spill& spill)
 {
+  if (auto n = negative_log_.take_expired())
+    WARN("<TimeDelta1D> {} more negative time differences not logged", n);
   if (!this->_accept_spill(spill))
     return;
-  timebase_ = spill.event_model.timebase;
+  timebase_ = spill.event_model->timebase;
   Spectrum::_push_stats_pre(spill);
 }
 
@@ -115,7 +117,7 @@ void TimeDelta1D::_push_event(const Event& event)
   if (event.timestamp() < previous_time_)
   {
     //TODO: do something smarter about this
-    WARN("<TimeDelta1D> Negative time difference occurred");
+    WARN_LIMITED(negative_log_, "<TimeDelta1D> Negative time difference occurred");
     previous_time_ = event.timestamp();
     return;
   }
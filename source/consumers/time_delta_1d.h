@@ -1,6 +1,7 @@
 #pragma once
 
 #include <consumers/spectrum.h>
+#include <core/util/log_limiter.h>
 
 namespace DAQuiri {
 
@@ -35,6 +36,7 @@ class TimeDelta1D : public Spectrum
     // recent pulse time
     bool have_previous_time_ {false};
     uint64_t previous_time_ {0};
+    LogLimiter negative_log_;
 
     std::vector<double> domain_;
 
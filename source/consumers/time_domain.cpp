@@ -100,7 +100,7 @@ void TimeDomain::_push_stats_pre(const Spill& spill)
   if (!this->_accept_spill(spill))
     return;
 
-  timebase_ = spill.event_model.timebase;
+  timebase_ = spill.event_model->timebase;
   Spectrum::_push_stats_pre(spill);
 }
 
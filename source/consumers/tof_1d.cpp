@@ -91,7 +91,7 @@ void TOF1D::_push_stats_pre(const Spill& spill)
 {
   if (!this->_accept_spill(spill))
     return;
-  timebase_ = spill.event_model.timebase;
+  timebase_ = spill.event_model->timebase;
   pulse_time_ = timebase_.to_nanosec(
       spill.state.find(Setting("pulse_time")).get_number());
   Spectrum::_push_stats_pre(spill);
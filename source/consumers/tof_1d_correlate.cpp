@@ -86,13 +86,13 @@ void TOF1DCorrelate::_push_stats_pre(const Spill& spill)
 
   if (spill.stream_id == chopper_stream_id_)
   {
-    chopper_timebase_ = spill.event_model.timebase;
+    chopper_timebase_ = spill.event_model->timebase;
     for (auto& e : spill.events)
       chopper_buffer_.push_back(e.timestamp());
   }
   else
   {
-    timebase_ = spill.event_model.timebase;
+    timebase_ = spill.event_model->timebase;
   }
 
   Spectrum::_push_stats_pre(spill);
@@ -65,12 +65,16 @@ void TOFVal2D::_init_from_file()
 
 void TOFVal2D::_recalc_axes()
 {
-  Detector det;
-  if (metadata_.detectors.size() == 1)
-    det = metadata_.detectors[0];
+  if (axes_stale_)
+  {
+    Detector det;
+    if (metadata_.detectors.size() == 1)
+      det = metadata_.detectors[0];
 
-  auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
-  data_->set_axis(1, DataAxis(calib, value_latch_.downsample));
+    auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
+    data_->define_axis(1, DataAxis(calib, value_latch_.downsample));
+    axes_stale_ = false;
+  }
 
   data_->recalc_axes();
 
@@ -88,7 +92,7 @@ void TOFVal2D::_push_stats_pre(const Spill& spill)
 {
   if (!this->_accept_spill(spill))
     return;
-  timebase_ = spill.event_model.timebase;
+  timebase_ = spill.event_model->timebase;
   pulse_time_ = timebase_.to_nanosec(
       spill.state.find(Setting("pulse_time")).get_number());
   value_latch_.configure(spill);
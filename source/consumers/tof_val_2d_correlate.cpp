@@ -70,12 +70,16 @@ void TOFVal2DCorrelate::_init_from_file()
 
 void TOFVal2DCorrelate::_recalc_axes()
 {
-  Detector det;
-  if (metadata_.detectors.size() == 1)
-    det = metadata_.detectors[0];
+  if (axes_stale_)
+  {
+    Detector det;
+    if (metadata_.detectors.size() == 1)
+      det = metadata_.detectors[0];
 
-  auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
-  data_->set_axis(1, DataAxis(calib, value_latch_.downsample));
+    auto calib = det.get_calibration({value_latch_.value_id, det.id()}, {value_latch_.value_id});
+    data_->define_axis(1, DataAxis(calib, value_latch_.downsample));
+    axes_stale_ = false;
+  }
 
   data_->recalc_axes();
 
@@ -103,13 +107,13 @@ void TOFVal2DCorrelate::_push_stats_pre(const Spill& spill)
 
   if (spill.stream_id == chopper_stream_id_)
   {
-    chopper_timebase_ = spill.event_model.timebase;
+    chopper_timebase_ = spill.event_model->timebase;
     for (auto& e : spill.events)
       chopper_buffer_.push_back(e.timestamp());
   }
   else
   {
-    timebase_ = spill.event_model.timebase;
+    timebase_ = spill.event_model->timebase;
     value_latch_.configure(spill);
   }
 
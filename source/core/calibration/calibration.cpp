@@ -85,7 +85,15 @@ Calibration::Calibration(CalibID from, CalibID to)
 bool Calibration::valid() const
 {
   // \todo should require to & from
-  return (function_ && !function_->coeffs().empty());
+  return (compiled_ && compiled_->valid());
+}
+
+void Calibration::compile()
+{
+  if (function_)
+    compiled_ = std::make_shared<CompiledCalibration>(function_);
+  else
+    compiled_ = nullptr;
 }
 
 CalibID Calibration::from() const
@@ -112,11 +120,13 @@ void Calibration::function(const std::string& type,
     for (size_t i = 0; i < coefs.size(); ++i)
       function_->set_coeff(i, coefs.at(i));
   }
+  compile();
 }
 
 void Calibration::function(CoefFunctionPtr f)
 {
   function_ = f;
+  compile();
 }
 
 CoefFunctionPtr Calibration::function() const
@@ -138,6 +148,7 @@ bool Calibration::operator==(const Calibration& other) const
   if (!function_ || !other.function_)
     return false;
   return (function_->type() == other.function_->type())
+      && (function_->x_offset() == other.function_->x_offset())
       && (function_->coeffs() == other.function_->coeffs());
 }
 
@@ -149,22 +160,26 @@ bool Calibration::operator!=(const Calibration& other) const
 double Calibration::transform(double chan) const
 {
   if (valid())
-    return (*function_)(chan);
+    return (*compiled_)(chan);
   return chan;
 }
 
 double Calibration::inverse(double val, double e) const
 {
   if (valid())
-    return function_->inverse(val, e);
+    return compiled_->inverse(val, e);
   return val;
 }
 
-void Calibration::transform_by_ref(std::vector<double>& data) const
+void Calibration::transform(double* data, size_t size) const
 {
   if (valid())
-    for (auto& d : data)
-      d = (*function_)(d);
+    compiled_->transform(data, size);
+}
+
+void Calibration::transform_by_ref(std::vector<double>& data) const
+{
+  transform(data.data(), data.size());
 }
 
 std::vector<double> Calibration::transform(const std::vector<double>& data) const
@@ -215,6 +230,7 @@ void from_json(const nlohmann::json& j, Calibration& s)
 
   if (j.count("function"))
     s.function_ = CoefFunctionFactory::singleton().create_from_json(j["function"]);
+  s.compile();
 }
 
 double shift_down(double v, uint16_t bits)
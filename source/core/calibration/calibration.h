@@ -1,7 +1,7 @@
 #pragma once
 
 #include <core/util/time_extensions.h>
-#include <core/calibration/coef_function.h>
+#include <core/calibration/compiled_calibration.h>
 
 #include <type_traits>
 
@@ -37,6 +37,9 @@ class Calibration
   hr_time_t created_{std::chrono::system_clock::now()};
   CalibID from_, to_;
   std::shared_ptr<CoefFunction> function_;
+  CompiledCalibrationPtr compiled_;
+
+  void compile();
 
  public:
   Calibration() = default;
@@ -57,6 +60,7 @@ class Calibration
 
   double transform(double) const;
   double inverse(double val, double e) const;
+  void transform(double* data, size_t size) const;
   void transform_by_ref(std::vector<double>&) const;
   std::vector<double> transform(const std::vector<double>& data) const;
 
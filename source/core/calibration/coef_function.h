@@ -22,9 +22,12 @@ class CoefFunction
   void set_coeff(int degree, const Parameter& p);
   std::map<int, Parameter> coeffs() const;
 
-  std::vector<double> eval(const std::vector<double>& x) const;
+  virtual std::vector<double> eval(const std::vector<double>& x) const;
   double inverse(double y, double e = 0.1) const;
 
+  //dense coefficients in (x - x_offset), empty if not a polynomial
+  virtual std::vector<double> polynomial_coeffs() const { return {}; }
+
   //TO IMPLEMENT IN CHILDREN
   virtual std::string type() const = 0;
   virtual CoefFunction* clone() const = 0;
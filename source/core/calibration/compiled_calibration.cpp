@@ -0,0 +1,218 @@
+#include <core/calibration/compiled_calibration.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace DAQuiri
+{
+
+CompiledCalibration::CompiledCalibration(CoefFunctionPtr function)
+    : function_(function)
+{
+  if (!function_)
+    return;
+
+  valid_ = !function_->coeffs().empty();
+  coeffs_ = function_->polynomial_coeffs();
+  x_offset_ = function_->x_offset().value();
+
+  for (size_t i = 1; i < coeffs_.size(); ++i)
+    derivative_.push_back(coeffs_[i] * i);
+
+  if (valid_ && flat())
+    build_inverse_table();
+}
+
+bool CompiledCalibration::valid() const
+{
+  return valid_;
+}
+
+bool CompiledCalibration::flat() const
+{
+  return !coeffs_.empty();
+}
+
+double CompiledCalibration::operator()(double x) const
+{
+  if (flat())
+    return evaluate(coeffs_, x);
+  if (function_)
+    return (*function_)(x);
+  return x;
+}
+
+void CompiledCalibration::transform(double* data, size_t size) const
+{
+  if (flat())
+    horner(coeffs_, x_offset_, data, size);
+  else if (function_)
+    for (size_t i = 0; i < size; ++i)
+      data[i] = (*function_)(data[i]);
+}
+
+void CompiledCalibration::horner(const std::vector<double>& coeffs, double x_offset,
+                                 double* data, size_t size)
+{
+  if (coeffs.empty())
+  {
+    std::fill(data, data + size, 0.0);
+    return;
+  }
+
+  const double* c = coeffs.data();
+  const size_t top = coeffs.size() - 1;
+
+  // fixed-width blocks so that the compiler can keep them in vector registers
+  constexpr size_t block {8};
+  size_t i = 0;
+  for (; i + block <= size; i += block)
+  {
+    double x[block];
+    double y[block];
+    for (size_t j = 0; j < block; ++j)
+    {
+      x[j] = data[i + j] - x_offset;
+      y[j] = c[top];
+    }
+    for (size_t k = top; k > 0; --k)
+    {
+      const double ck = c[k - 1];
+      for (size_t j = 0; j < block; ++j)
+        y[j] = y[j] * x[j] + ck;
+    }
+    for (size_t j = 0; j < block; ++j)
+      data[i + j] = y[j];
+  }
+
+  for (; i < size; ++i)
+  {
+    double x = data[i] - x_offset;
+    double y = c[top];
+    for (size_t k = top; k > 0; --k)
+      y = y * x + c[k - 1];
+    data[i] = y;
+  }
+}
+
+double CompiledCalibration::evaluate(const std::vector<double>& coeffs, double x) const
+{
+  if (coeffs.empty())
+    return 0.0;
+  x -= x_offset_;
+  double y = coeffs.back();
+  for (size_t k = coeffs.size() - 1; k > 0; --k)
+    y = y * x + coeffs[k - 1];
+  return y;
+}
+
+double CompiledCalibration::derivative(double x) const
+{
+  return evaluate(derivative_, x);
+}
+
+void CompiledCalibration::build_inverse_table()
+{
+  inverse_table_.resize(inverse_table_size);
+  for (size_t i = 0; i < inverse_table_size; ++i)
+    inverse_table_[i] = i * inverse_table_step;
+  transform(inverse_table_.data(), inverse_table_.size());
+
+  ascending_ = (inverse_table_.back() > inverse_table_.front());
+  for (size_t i = 1; i < inverse_table_size; ++i)
+  {
+    if (ascending_ ? (inverse_table_[i] <= inverse_table_[i - 1])
+                   : (inverse_table_[i] >= inverse_table_[i - 1]))
+    {
+      inverse_table_.clear();
+      return;
+    }
+  }
+}
+
+bool CompiledCalibration::inverse_bracket(double y, double& lo, double& hi) const
+{
+  if (inverse_table_.empty())
+    return false;
+
+  size_t upper;
+  if (ascending_)
+  {
+    if ((y < inverse_table_.front()) || (y > inverse_table_.back()))
+      return false;
+    upper = std::lower_bound(inverse_table_.begin(), inverse_table_.end(), y)
+        - inverse_table_.begin();
+  }
+  else
+  {
+    if ((y > inverse_table_.front()) || (y < inverse_table_.back()))
+      return false;
+    upper = std::lower_bound(inverse_table_.begin(), inverse_table_.end(), y,
+                             [](double a, double b) { return a > b; })
+        - inverse_table_.begin();
+  }
+
+  //y is the first sample exactly
+  lo = hi = upper * inverse_table_step;
+  if (upper > 0)
+    lo -= inverse_table_step;
+  return true;
+}
+
+double CompiledCalibration::bisect(double y, double lo, double hi, double e) const
+{
+  for (int i = 0; (i < 200) && ((hi - lo) > e); ++i)
+  {
+    double mid = 0.5 * (lo + hi);
+    double v = evaluate(coeffs_, mid);
+    if (ascending_ ? (v < y) : (v > y))
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return 0.5 * (lo + hi);
+}
+
+double CompiledCalibration::inverse(double y, double e) const
+{
+  if (!flat())
+  {
+    if (function_)
+      return function_->inverse(y, e);
+    return y;
+  }
+
+  //seeded from the sampled table when y is within it
+  double lo {0}, hi {0};
+  bool bracketed = inverse_bracket(y, lo, hi);
+  double x0 = x_offset_;
+  if (bracketed && (hi > lo))
+  {
+    double y0 = evaluate(coeffs_, lo);
+    double y1 = evaluate(coeffs_, hi);
+    x0 = lo + (hi - lo) * (y - y0) / (y1 - y0);
+  }
+  else if (bracketed)
+    x0 = lo;
+
+  for (int i = 0; i <= 100; ++i)
+  {
+    //flat spots and steps out of the bracket go to bisection
+    double d = derivative(x0);
+    double x1 = (d != 0.0) ? (x0 + (y - evaluate(coeffs_, x0)) / d) : nan("");
+    if (!std::isfinite(x1) || (bracketed && ((x1 < lo) || (x1 > hi))))
+    {
+      if (!bracketed)
+        return nan("");
+      return bisect(y, lo, hi, e) - x_offset_;
+    }
+
+    // same convention as CoefFunction::inverse
+    if (std::abs(x1 - x0) <= e)
+      return x1 - x_offset_;
+    x0 = x1;
+  }
+  return nan("");
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <core/calibration/coef_function.h>
+
+namespace DAQuiri
+{
+
+// Immutable, flattened form of a calibration function for bulk evaluation.
+// Polynomials are evaluated with Horner's scheme over contiguous coefficients,
+// other function types fall back to their virtual methods.
+class CompiledCalibration
+{
+ public:
+  CompiledCalibration() = default;
+  CompiledCalibration(CoefFunctionPtr function);
+
+  bool valid() const;
+  bool flat() const;
+
+  double operator()(double x) const;
+  void transform(double* data, size_t size) const;
+  double inverse(double y, double e) const;
+
+  //in-place batch evaluation, coefficients ordered by degree
+  static void horner(const std::vector<double>& coeffs, double x_offset,
+                     double* data, size_t size);
+
+  //channels sampled for seeding inverse lookups
+  static constexpr size_t inverse_table_step {16};
+  static constexpr size_t inverse_table_size {4097};
+
+ private:
+  CoefFunctionPtr function_;
+  bool valid_ {false};
+
+  std::vector<double> coeffs_;
+  std::vector<double> derivative_;
+  double x_offset_ {0};
+
+  //function values at multiples of inverse_table_step, empty if not monotonic
+  std::vector<double> inverse_table_;
+  bool ascending_ {true};
+
+  double evaluate(const std::vector<double>& coeffs, double x) const;
+  double derivative(double x) const;
+  //table samples around y, false if it is outside the table
+  bool inverse_bracket(double y, double& lo, double& hi) const;
+  double bisect(double y, double lo, double hi, double e) const;
+  void build_inverse_table();
+};
+
+using CompiledCalibrationPtr = std::shared_ptr<const CompiledCalibration>;
+
+}
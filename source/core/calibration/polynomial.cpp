@@ -1,4 +1,5 @@
 #include <core/calibration/polynomial.h>
+#include <core/calibration/compiled_calibration.h>
 
 #include <core/util/UTF_extensions.h>
 #include <core/util/lexical_extensions.h>
@@ -101,6 +102,29 @@ double Polynomial::operator()(double x) const
   return result;
 }
 
+std::vector<double> Polynomial::polynomial_coeffs() const
+{
+  if (coeffs_.empty() || (coeffs_.begin()->first < 0))
+    return {};
+
+  // missing degrees are zero
+  std::vector<double> c(coeffs_.rbegin()->first + 1, 0.0);
+  for (auto& p : coeffs_)
+    c[p.first] = p.second.value();
+  return c;
+}
+
+std::vector<double> Polynomial::eval(const std::vector<double>& x) const
+{
+  auto c = polynomial_coeffs();
+  if (c.empty())
+    return CoefFunction::eval(x);
+
+  std::vector<double> y = x;
+  CompiledCalibration::horner(c, xoffset_.value(), y.data(), y.size());
+  return y;
+}
+
 double Polynomial::derivative(double x) const
 {
   Polynomial new_poly;  // derivative not true if offset != 0
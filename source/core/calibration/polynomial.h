@@ -14,6 +14,8 @@ class Polynomial : public CoefFunction
   Polynomial* clone() const override { return new Polynomial(*this); }
   double operator() (double x) const override;
   double derivative(double) const override;
+  std::vector<double> eval(const std::vector<double>& x) const override;
+  std::vector<double> polynomial_coeffs() const override;
 
   std::string debug() const override;
   std::string to_UTF8(int precision, bool with_rsq) const override;
@@ -4,6 +4,7 @@
 #include <core/util/logger.h>
 #include <core/util/timer.h>
 #include <core/util/h5json.h>
+#include <algorithm>
 
 namespace DAQuiri {
 
@@ -19,6 +20,32 @@ Consumer::Consumer()
   metadata_.overwrite_all_attributes(attributes);
 }
 
+Setting ConsumerProfile::settings() const
+{
+  auto counter = [](std::string id, std::string descr, uint64_t val)
+  {
+    SettingMeta m(id, SettingType::integer, descr);
+    m.set_flag("readonly");
+    m.set_val("min", 0);
+    Setting s(m);
+    s.set_int(val);
+    return s;
+  };
+
+  SettingMeta pm("profile", SettingType::stem, "Binning cost");
+  pm.set_flag("readonly");
+  pm.set_flag("transient");
+  Setting ret(pm);
+  ret.branches.add_a(counter("profile_spills", "Spills", spills));
+  ret.branches.add_a(counter("profile_events", "Events offered", events));
+  ret.branches.add_a(counter("profile_accepted", "Events accepted by filters", events_accepted));
+  ret.branches.add_a(counter("profile_rejected", "Events rejected by filters", events_rejected));
+  ret.branches.add_a(counter("profile_pre_ns", "Time in pre-spill stats (ns)", pre_ns));
+  ret.branches.add_a(counter("profile_events_ns", "Time in event loop (ns)", events_ns));
+  ret.branches.add_a(counter("profile_post_ns", "Time in post-spill stats (ns)", post_ns));
+  return ret;
+}
+
 void Consumer::_apply_attributes()
 {
 //  metadata_.disable_presets();
@@ -74,12 +101,22 @@ void Consumer::from_prototype(const ConsumerMetadata& newtemplate)
   }
 
   metadata_.detectors.clear(); // really?
+  attributes_generation_++;
 }
 
 void Consumer::push_spill(const Spill& spill)
 {
   UNIQUE_LOCK_EVENTUALLY_ST
-  this->_push_spill(spill);
+  this->_push_spill(spill, 0, spill.events.size());
+}
+
+void Consumer::push_spill(const Spill& spill, size_t begin, size_t end,
+                          SpillCache* cache)
+{
+  UNIQUE_LOCK_EVENTUALLY_ST
+  cache_ = cache;
+  this->_push_spill(spill, begin, end);
+  cache_ = nullptr;
 }
 
 bool Consumer::_accept_spill(const Spill& spill)
@@ -87,31 +124,71 @@ bool Consumer::_accept_spill(const Spill& spill)
   return (spill.stream_id == stream_id_);
 }
 
-void Consumer::_push_spill(const Spill& spill)
+void Consumer::_push_spill(const Spill& spill, size_t begin, size_t end)
 {
-//  Timer addspill_timer(true);
+  using clock = std::chrono::steady_clock;
+  auto ns = [](clock::time_point from, clock::time_point to)
+  {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+  };
 
 //  if (!spill.detectors.empty())
 //    this->_set_detectors(spill.detectors);
 
-  this->_push_stats_pre(spill);
+  end = std::min(end, spill.events.size());
 
-  if (this->_accept_spill(spill) && this->_accept_events(spill))
-    for (auto& q : spill.events)
-      this->_push_event(q);
+  auto t0 = clock::now();
+  //pre-stats once per spill, chunks of the spill in progress continue it
+  bool continued = (begin > 0) && chunk_open_ && (chunk_sequence_ == spill.sequence);
+  if (!continued)
+  {
+    this->_push_stats_pre(spill);
+    chunk_open_ = true;
+    chunk_sequence_ = spill.sequence;
+    chunk_accepted_ = this->_accept_spill(spill);
+    chunk_events_ = chunk_accepted_ && this->_accept_events(spill);
+  }
+  auto t1 = clock::now();
+
+  if (chunk_events_ && (begin < end))
+  {
+    this->_push_events(spill, begin, end);
+    profile_.events += (end - begin);
+    generation_++;
+  }
+  auto t2 = clock::now();
 
-  this->_push_stats_post(spill);
+  if (end == spill.events.size())
+  {
+    this->_push_stats_post(spill);
+    chunk_open_ = false;
+    if (chunk_accepted_)
+    {
+      generation_++;
+      profile_.spills++;
+    }
+  }
+  auto t3 = clock::now();
 
-//  DBG( "<" << metadata_.get_attribute("name").get_text() << "> added "
-//      << spill.events.size() << " events in "
-//      << addspill_timer.ms() << " ms at "
-//      << addspill_timer.us() / double(spill.events.size()) << " us/hit";
+  profile_.pre_ns += ns(t0, t1);
+  profile_.events_ns += ns(t1, t2);
+  profile_.post_ns += ns(t2, t3);
+}
+
+void Consumer::_push_events(const Spill& spill, size_t begin, size_t end)
+{
+  auto first = spill.events.begin() + begin;
+  auto last = spill.events.begin() + end;
+  for (auto q = first; q != last; ++q)
+    this->_push_event(*q);
 }
 
 void Consumer::flush()
 {
   UNIQUE_LOCK_EVENTUALLY_ST
   this->_flush();
+  generation_++;
 }
 
 bool Consumer::changed() const
@@ -120,11 +197,33 @@ bool Consumer::changed() const
   return changed_;
 }
 
+uint64_t Consumer::generation() const
+{
+  return generation_.load();
+}
+
+uint64_t Consumer::attributes_generation() const
+{
+  return attributes_generation_.load();
+}
+
+std::set<std::string> Consumer::streams() const
+{
+  SHARED_LOCK_ST
+  std::set<std::string> ret;
+  for (const auto& a : metadata_.attributes_flat())
+    if (a.metadata().has_flag("stream"))
+      ret.insert(a.get_text());
+  return ret;
+}
+
 void Consumer::set_detectors(const std::vector<Detector>& dets)
 {
   UNIQUE_LOCK_EVENTUALLY_ST
+  chunk_events_ = false;
   this->_set_detectors(dets);
   changed_ = true;
+  generation_++;
 }
 
 void Consumer::reset_changed()
@@ -137,7 +236,18 @@ void Consumer::reset_changed()
 ConsumerMetadata Consumer::metadata() const
 {
   SHARED_LOCK_ST
-  return metadata_;
+  auto ret = metadata_;
+  //filled in on demand to keep it off the acquisition path
+  auto attributes = ret.attributes();
+  attributes.branches.replace(profile_.settings());
+  ret.overwrite_all_attributes(attributes);
+  return ret;
+}
+
+ConsumerProfile Consumer::profile() const
+{
+  SHARED_LOCK_ST
+  return profile_;
 }
 
 DataspacePtr Consumer::data() const
@@ -151,6 +261,7 @@ DataspacePtr Consumer::data() const
 void Consumer::import(const Importer& i)
 {
   UNIQUE_LOCK_EVENTUALLY_ST
+  chunk_events_ = false;
   this->data_->clear();
   for (auto& q : i.entry_list)
   {
@@ -159,6 +270,7 @@ void Consumer::import(const Importer& i)
 
   this->_recalc_axes();
   this->_flush();
+  generation_++;
 }
 
 std::string Consumer::type() const
@@ -197,17 +309,23 @@ std::string Consumer::debug(std::string prepend, bool verbose) const
 void Consumer::set_attribute(const Setting& setting, bool greedy)
 {
   UNIQUE_LOCK_EVENTUALLY_ST
+  chunk_events_ = false;
   metadata_.set_attribute(setting, greedy);
   this->_apply_attributes();
   changed_ = true;
+  generation_++;
+  attributes_generation_++;
 }
 
 void Consumer::set_attributes(const Setting& settings)
 {
   UNIQUE_LOCK_EVENTUALLY_ST
+  chunk_events_ = false;
   metadata_.set_attributes(settings.branches.data(), true);
   this->_apply_attributes();
   changed_ = true;
+  generation_++;
+  attributes_generation_++;
 }
 
 /////////////////////
@@ -231,6 +349,8 @@ void Consumer::load(hdf5::node::Group& g, bool withdata)
       data_->load(g);
 
     this->_init_from_file();
+    generation_++;
+    attributes_generation_++;
   }
   catch (...)
   {
@@ -2,8 +2,11 @@
 
 #include <core/consumer_metadata.h>
 #include <core/spill.h>
+#include <core/spill_cache.h>
 #include <core/dataspace.h>
 
+#include <atomic>
+
 namespace DAQuiri
 {
 
@@ -13,6 +16,23 @@ class Consumer;
 
 using ConsumerPtr = std::shared_ptr<Consumer>;
 
+//where a consumer spends its time, accumulated since construction
+struct ConsumerProfile
+{
+  uint64_t spills {0};
+  uint64_t events {0};
+  uint64_t events_accepted {0};
+  uint64_t events_rejected {0};
+  uint64_t pre_ns {0};
+  uint64_t events_ns {0};
+  uint64_t post_ns {0};
+
+  uint64_t total_ns() const { return pre_ns + events_ns + post_ns; }
+
+  //readonly, transient attributes, as reported in Consumer::metadata()
+  Setting settings() const;
+};
+
 class Consumer
 {
  protected:
@@ -21,11 +41,19 @@ class Consumer
   DataspacePtr data_;
   bool changed_{false};
 
+  //bumped whenever data or metadata may have changed, readable without lock
+  std::atomic<uint64_t> generation_{0};
+
+  //bumped whenever attributes are changed from outside
+  std::atomic<uint64_t> attributes_generation_{0};
+
  public:
   Consumer();
   Consumer(const Consumer& other)
       : metadata_(other.metadata_)
         , changed_{true}
+        , generation_{other.generation_.load()}
+        , attributes_generation_{other.attributes_generation_.load()}
   {
     if (other.data_)
       data_ = DataspacePtr(other.data_->clone());
@@ -42,6 +70,11 @@ class Consumer
 
   //data acquisition
   void push_spill(const Spill&);
+  //events [begin, end) of a spill pushed in chunks, pre-stats are applied
+  //with the first chunk and post-stats with the one reaching the end;
+  //cache, if given, holds results shared with other consumers of the spill
+  void push_spill(const Spill&, size_t begin, size_t end,
+                  SpillCache* cache = nullptr);
   void flush();
 
   ConsumerMetadata metadata() const;
@@ -49,6 +82,12 @@ class Consumer
 
   void reset_changed();
   bool changed() const;
+  uint64_t generation() const;
+  uint64_t attributes_generation() const;
+  ConsumerProfile profile() const;
+
+  //values of attributes flagged "stream", spills of other streams are ignored
+  std::set<std::string> streams() const;
 
   //Convenience functions for most common metadata
   std::string type() const;
@@ -73,19 +112,34 @@ class Consumer
 
   virtual void _set_detectors(const std::vector<Detector>& dets);
 
-  virtual void _push_spill(const Spill&);
+  virtual void _push_spill(const Spill&, size_t begin, size_t end);
 
   virtual bool _accept_spill(const Spill& spill) = 0;
   virtual bool _accept_events(const Spill& spill) = 0;
 
   virtual void _push_stats_pre(const Spill&) {}
+  //events [begin, end) of an accepted spill, one by one unless overridden
+  virtual void _push_events(const Spill&, size_t begin, size_t end);
   virtual void _push_event(const Event&) = 0;
   virtual void _push_stats_post(const Spill&) {}
 
   virtual void _flush() {}
 
+  //filter tallies are counted by subclasses where they loop over events
+  ConsumerProfile profile_;
+
+  //shared results for the spill being pushed, may be null
+  SpillCache* cache_ {nullptr};
+
  private:
   std::string stream_id_;
+
+  //spill whose chunks are being pushed, by sequence number;
+  //reconfiguring meanwhile skips its remaining events, not its stats
+  bool chunk_open_ {false};
+  uint64_t chunk_sequence_ {0};
+  bool chunk_accepted_ {false};
+  bool chunk_events_ {false};
 };
 
 }
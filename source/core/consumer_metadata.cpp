@@ -1,13 +1,55 @@
 #include <core/consumer_metadata.h>
 #include <core/util/ascii_tree.h>
+#include <atomic>
 
 namespace DAQuiri {
 
-ConsumerMetadata::ConsumerMetadata() {}
+AttributeHandle::AttributeHandle(std::string id, std::set<int32_t> indices)
+  : address_(id)
+{
+  address_.set_indices(indices);
+}
+
+ConsumerMetadata::ConsumerMetadata()
+{
+  reindex();
+}
 
 ConsumerMetadata::ConsumerMetadata(std::string tp,
                                    std::string descr)
-    : type_(tp), type_description_(descr) {}
+    : type_(tp), type_description_(descr)
+{
+  reindex();
+}
+
+ConsumerMetadata::ConsumerMetadata(const ConsumerMetadata& other)
+    : type_(other.type_)
+    , type_description_(other.type_description_)
+    , attributes_(other.attributes_)
+    , detectors(other.detectors)
+{
+  reindex();
+}
+
+ConsumerMetadata& ConsumerMetadata::operator=(const ConsumerMetadata& other)
+{
+  if (this == &other)
+    return *this;
+  type_ = other.type_;
+  type_description_ = other.type_description_;
+  attributes_ = other.attributes_;
+  detectors = other.detectors;
+  reindex();
+  return *this;
+}
+
+void ConsumerMetadata::reindex()
+{
+  //unique across instances, so handles never resolve into a copy
+  static std::atomic<uint64_t> layouts {0};
+  layout_ = ++layouts;
+  index_.rebuild(attributes_);
+}
 
 ConsumerMetadata ConsumerMetadata::prototype() const
 {
@@ -15,6 +57,7 @@ ConsumerMetadata ConsumerMetadata::prototype() const
 
   ret.attributes_.enable_if_flag(true, "preset");
   ret.attributes_.cull_readonly();
+  ret.reindex();
 
   return ret;
 }
@@ -62,29 +105,69 @@ std::string ConsumerMetadata::debug(std::string prepend, bool verbose) const
 
 Setting ConsumerMetadata::get_attribute(Setting setting) const
 {
-  return attributes_.find(setting, Match::id | Match::indices);
+  auto node = index_.find(setting, Match::id | Match::indices);
+  if (node)
+    return *node;
+  return Setting();
 }
 
 Setting ConsumerMetadata::get_attribute(std::string setting) const
 {
-  return attributes_.find(Setting(setting), Match::id | Match::indices);
+  return get_attribute(Setting(setting));
 }
 
 Setting ConsumerMetadata::get_attribute(std::string setting, int32_t idx) const
 {
   Setting find(setting);
   find.set_indices({idx});
-  return attributes_.find(find, Match::id | Match::indices);
+  return get_attribute(find);
 }
 
 void ConsumerMetadata::replace_attribute(const Setting& setting, bool greedy)
 {
   attributes_.replace(setting, Match::id | Match::indices, greedy);
+  reindex();
 }
 
 void ConsumerMetadata::set_attribute(const Setting& setting, bool greedy)
 {
-  attributes_.set(setting, Match::id | Match::indices, greedy);
+  if (greedy)
+  {
+    for (auto node : index_.find_all(setting, Match::id | Match::indices))
+      node->set_val(setting);
+    return;
+  }
+  auto node = index_.find_for_set(setting, Match::id | Match::indices);
+  if (node)
+    node->set_val(setting);
+}
+
+AttributeHandle ConsumerMetadata::handle(std::string id,
+                                         std::set<int32_t> indices)
+{
+  AttributeHandle ret(id, indices);
+  attribute(ret);
+  return ret;
+}
+
+Setting* ConsumerMetadata::attribute(AttributeHandle& handle)
+{
+  if (handle.layout_ != layout_)
+  {
+    handle.node_ = index_.find(handle.address_, Match::id | Match::indices);
+    handle.layout_ = layout_;
+  }
+  return handle.node_;
+}
+
+const Setting* ConsumerMetadata::attribute(AttributeHandle& handle) const
+{
+  if (handle.layout_ != layout_)
+  {
+    handle.node_ = index_.find(handle.address_, Match::id | Match::indices);
+    handle.layout_ = layout_;
+  }
+  return handle.node_;
 }
 
 Setting ConsumerMetadata::attributes() const
@@ -114,6 +197,7 @@ void ConsumerMetadata::set_attributes(const std::list<Setting>& s, bool greedy)
 void ConsumerMetadata::overwrite_all_attributes(Setting settings)
 {
   attributes_ = settings;
+  reindex();
 }
 
 void ConsumerMetadata::disable_presets()
@@ -127,8 +211,14 @@ void to_json(json& j, const ConsumerMetadata& s)
   {
     j["type"] = s.type_;
 
-    if (s.attributes_.branches.size())
-      j["attributes"] = s.attributes_;
+    //transient attributes, e.g. the binning profile, are never saved
+    Setting attributes = s.attributes_;
+    for (const auto& a : s.attributes_.branches)
+      if (a.metadata().has_flag("transient"))
+        attributes.branches.remove_a(a);
+
+    if (attributes.branches.size())
+      j["attributes"] = attributes;
 
     if (!s.detectors.empty())
       for (auto& d : s.detectors)
@@ -149,6 +239,7 @@ void from_json(const json& j, ConsumerMetadata& s)
 
     if (j.count("attributes"))
       s.attributes_ = j["attributes"];
+    s.reindex();
 
     if (j.count("detectors"))
     {
@@ -199,6 +290,7 @@ void ConsumerMetadata::set_det_limit(uint16_t limit)
         }
       }
     }
+  reindex();
 }
 
 bool ConsumerMetadata::chan_relevant(uint16_t chan) const
@@ -1,14 +1,35 @@
 #pragma once
 
 #include <core/detector.h>
+#include <core/plugin/setting_index.h>
 
 namespace DAQuiri {
 
+// an attribute resolved once, e.g. in _apply_attributes, for repeated
+// access on the acquisition path; re-resolved automatically if the
+// attribute tree has changed shape since
+class AttributeHandle
+{
+public:
+  AttributeHandle() {}
+  AttributeHandle(std::string id, std::set<int32_t> indices = {});
+
+  std::string id() const { return address_.id(); }
+
+private:
+  friend class ConsumerMetadata;
+  Setting address_;
+  Setting* node_ {nullptr};
+  uint64_t layout_ {0};
+};
+
 class ConsumerMetadata
 {
 public:
   ConsumerMetadata();
   ConsumerMetadata(std::string tp, std::string descr);
+  ConsumerMetadata(const ConsumerMetadata& other);
+  ConsumerMetadata& operator=(const ConsumerMetadata& other);
 
   ConsumerMetadata prototype() const;
 
@@ -23,6 +44,11 @@ public:
   void set_attributes(const std::list<Setting> &s, bool greedy = false);
   void overwrite_all_attributes(Setting settings);
 
+  AttributeHandle handle(std::string id, std::set<int32_t> indices = {});
+  // nullptr if no such attribute
+  Setting* attribute(AttributeHandle& handle);
+  const Setting* attribute(AttributeHandle& handle) const;
+
   //read only
   std::string type() const {return type_;}
   std::string type_description() const {return type_description_;}
@@ -49,6 +75,11 @@ private:
   //can change these
   Setting attributes_ {SettingMeta("Attributes", SettingType::stem)};
 
+  //must be rebuilt whenever attributes_ changes shape
+  SettingIndex index_;
+  uint64_t layout_ {0};
+  void reindex();
+
 public:
   std::vector<Detector> detectors;
 
@@ -2,6 +2,7 @@
 #include <core/util/ascii_tree.h>
 #include <core/util/h5json.h>
 
+#include <algorithm>
 #include <codecvt>
 #include <locale>
 
@@ -25,15 +26,28 @@ void DataAxis::expand_domain(size_t ubound)
     return;
 
   size_t oldbound = domain.size();
-  domain.resize(ubound + 1);
+  std::vector<double> chans(ubound + 1 - oldbound);
 
-  for (size_t i = oldbound; i <= ubound; ++i)
-  {
-    double ii = i;
-    if (resample_shift_)
-      ii = shift(ii, resample_shift_);
-    domain[i] = calibration.transform(ii);
-  }
+  double factor = shift(1.0, resample_shift_);
+  for (size_t i = 0; i < chans.size(); ++i)
+    chans[i] = (oldbound + i) * factor;
+
+  calibration.transform_by_ref(chans);
+  domain.insert(domain.end(), chans.begin(), chans.end());
+}
+
+void DataAxis::fit_domain(size_t ubound)
+{
+  if (ubound < domain.size())
+    domain.resize(ubound + 1);
+  else
+    expand_domain(ubound);
+}
+
+bool DataAxis::same_definition(const DataAxis& other) const
+{
+  return (resample_shift_ == other.resample_shift_)
+      && (calibration == other.calibration);
 }
 
 Pair DataAxis::bounds() const
@@ -95,11 +109,119 @@ Dataspace::Dataspace(const Dataspace& other)
     : axes_(other.axes_), dimensions_(other.dimensions_), total_count_(other.total_count_) {}
 
 EntryList Dataspace::all_data() const
+{
+  return this->range(axis_bounds());
+}
+
+std::vector<Pair> Dataspace::axis_bounds() const
 {
   std::vector<Pair> ranges;
-  for (auto a : axes_)
+  for (const auto& a : axes_)
     ranges.push_back(a.bounds());
-  return this->range(ranges);
+  return ranges;
+}
+
+Coords Dataspace::binning_factors(const std::vector<Pair>& ranges,
+                                  const Coords& resolution)
+{
+  Coords factors(ranges.size(), 1);
+  for (size_t i = 0; (i < ranges.size()) && (i < resolution.size()); ++i)
+  {
+    if (!resolution[i])
+      continue;
+    size_t extent = std::max(ranges[i].first, ranges[i].second)
+        - std::min(ranges[i].first, ranges[i].second) + 1;
+    factors[i] = std::max((extent + resolution[i] - 1) / resolution[i],
+                          size_t(1));
+  }
+  return factors;
+}
+
+EntryList Dataspace::range_unbinned(const std::vector<Pair>& ranges) const
+{
+  auto fine = this->range(ranges);
+  if (fine && (ranges.size() == dimensions_))
+    for (auto& e : *fine)
+      for (size_t i = 0; i < dimensions_; ++i)
+        e.first[i] -= std::min(ranges[i].first, ranges[i].second);
+  return fine;
+}
+
+EntryList Dataspace::range_binned(std::vector<Pair> ranges,
+                                  const Coords& resolution) const
+{
+  if (ranges.size() != dimensions_)
+    ranges = axis_bounds();
+  if (ranges.size() != dimensions_)
+    return this->range(ranges);
+
+  auto factors = binning_factors(ranges, resolution);
+  if (std::all_of(factors.begin(), factors.end(),
+                  [](size_t f) { return f == 1; }))
+    return range_unbinned(ranges);
+
+  TileBuffer tiles(ranges, factors);
+  auto fine = this->range(ranges);
+  if (!tiles.valid())
+    return fine;
+  for (const auto& e : *fine)
+    tiles.add(e.first, e.second);
+  return tiles.entries();
+}
+
+Dataspace::TileBuffer::TileBuffer(const std::vector<Pair>& ranges,
+                                  const Coords& factors)
+  : mins_(ranges.size())
+  , maxs_(ranges.size())
+  , factors_(factors)
+  , tiles_(ranges.size())
+{
+  //bounded by the requested resolution
+  size_t total_tiles{1};
+  for (size_t i = 0; i < ranges.size(); ++i)
+  {
+    mins_[i] = std::min(ranges[i].first, ranges[i].second);
+    maxs_[i] = std::max(ranges[i].first, ranges[i].second);
+    size_t extent = maxs_[i] - mins_[i] + 1;
+    if (!extent) //undefined axis
+      return;
+    tiles_[i] = (extent + factors_[i] - 1) / factors_[i];
+    total_tiles *= tiles_[i];
+  }
+  buffer_.assign(total_tiles, 0);
+}
+
+EntryList Dataspace::TileBuffer::entries() const
+{
+  EntryList result(new EntryList_t);
+  Coords coords(tiles_.size());
+  for (size_t idx = 0; idx < buffer_.size(); ++idx)
+  {
+    if (!buffer_[idx])
+      continue;
+    size_t rem = idx;
+    for (size_t i = tiles_.size(); i > 0; --i)
+    {
+      coords[i - 1] = rem % tiles_[i - 1];
+      rem /= tiles_[i - 1];
+    }
+    result->push_back({coords, buffer_[idx]});
+  }
+  return result;
+}
+
+void Dataspace::add_trace(const uint32_t* trace, size_t size,
+                          uint16_t downsample)
+{
+  if (dimensions_ != 1)
+    return;
+  Entry entry{{0}, 0};
+  for (size_t i = 0; i < size; ++i)
+  {
+    entry.first[0] = (i >> downsample);
+    entry.second = trace[i];
+    this->add(entry);
+  }
 }
 
 DataAxis Dataspace::axis(uint16_t dimension) const
@@ -117,6 +239,24 @@ void Dataspace::set_axis(size_t dim, const DataAxis& ax)
 //  else throw?
 }
 
+void Dataspace::define_axis(size_t dim, const DataAxis& ax)
+{
+  if ((dim < dimensions()) && this->axis(dim).same_definition(ax))
+    return;
+  this->set_axis(dim, ax);
+}
+
+void Dataspace::fit_axis(uint16_t dimension, size_t ubound)
+{
+  if (dimension >= dimensions())
+    return;
+  auto ax = this->axis(dimension);
+  if (ax.domain.size() == (ubound + 1))
+    return;
+  ax.fit_domain(ubound);
+  this->set_axis(dimension, ax);
+}
+
 uint16_t Dataspace::dimensions() const
 {
   return dimensions_;
@@ -26,6 +26,8 @@ struct DataAxis
   DataAxis(Calibration c, std::vector<double> dom);
 
   void expand_domain(size_t ubound);
+  void fit_domain(size_t ubound);
+  bool same_definition(const DataAxis& other) const;
 
   std::string label() const;
   std::string debug() const;
@@ -59,10 +61,22 @@ class Dataspace
     virtual EntryList range(std::vector<Pair> ranges = {}) const = 0;
     EntryList all_data() const;
 
+    //level-of-detail retrieval: bins are summed into tiles so that each
+    //dimension has at most resolution[d] tiles (0 = no downsampling);
+    //returned coordinates are tile indices relative to range start
+    virtual EntryList range_binned(std::vector<Pair> ranges,
+                                   const Coords& resolution) const;
+    //how many bins are summed into a tile in each dimension
+    static Coords binning_factors(const std::vector<Pair>& ranges,
+                                  const Coords& resolution);
+
     virtual void clear() = 0;
     virtual void reserve(const Coords &) {}
     virtual void add(const Entry &) = 0;
     virtual void add_one(const Coords &) = 0;
+    //adds a whole prebinned 1D trace, bin i goes to (i >> downsample)
+    virtual void add_trace(const uint32_t* trace, size_t size,
+                           uint16_t downsample = 0);
     virtual void recalc_axes() = 0;
 
     virtual void export_csv(std::ostream &) const = 0;
@@ -75,6 +89,8 @@ class Dataspace
     virtual bool empty() const = 0;
     virtual DataAxis axis(uint16_t dimension) const;
     virtual void set_axis(size_t dim, const DataAxis &ax);
+    //keeps cached domain if calibration and resampling are unchanged
+    void define_axis(size_t dim, const DataAxis &ax);
 
     std::string debug(std::string prepend = "") const;
 
@@ -84,6 +100,50 @@ class Dataspace
 
     PreciseFloat total_count_ {0};
 
+    //full bounds of all axes, used when no ranges are given
+    std::vector<Pair> axis_bounds() const;
+
+    //dense tile sums for range_binned(); backends that can walk their
+    //cells add them straight in instead of building range() first
+    class TileBuffer
+    {
+      public:
+        TileBuffer(const std::vector<Pair>& ranges, const Coords& factors);
+
+        //false if an axis is undefined
+        bool valid() const { return !buffer_.empty(); }
+
+        //bin must lie within ranges
+        inline void add(const Coords& bin, PreciseFloat count)
+        {
+          size_t idx{0};
+          for (size_t i = 0; i < bin.size(); ++i)
+            idx = idx * tiles_[i] + (bin[i] - mins_[i]) / factors_[i];
+          buffer_[idx] += count;
+        }
+
+        //non-empty tiles, coordinates relative to range start
+        EntryList entries() const;
+
+        //requested ranges, inclusive
+        const Coords& mins() const { return mins_; }
+        const Coords& maxs() const { return maxs_; }
+
+      private:
+        Coords mins_;
+        Coords maxs_;
+        Coords factors_;
+        Coords tiles_;
+        std::vector<PreciseFloat> buffer_;
+    };
+
+    //range_binned() when no bins are summed: tiles are bins, still
+    //relative to range start
+    EntryList range_unbinned(const std::vector<Pair>& ranges) const;
+
+    //grows or trims cached domain in place to cover [0, ubound]
+    void fit_axis(uint16_t dimension, size_t ubound);
+
     virtual std::string data_debug(const std::string &prepend) const;
     virtual void data_load(const hdf5::node::Group&) = 0;
     virtual void data_save(const hdf5::node::Group&) const = 0;
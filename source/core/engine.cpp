@@ -1,14 +1,34 @@
 #include <core/engine.h>
 #include <core/util/logger.h>
 #include <core/util/timer.h>
+#include <core/spill_pool.h>
+#include <core/list_file.h>
 #include <core/producer_factory.h>
 
 #include <functional>
+#include <algorithm>
+#include <cmath>
 
 #define THREAD_CLOSE_WAIT_TIME_MS 100
 
 namespace DAQuiri {
 
+//longest the control loop sleeps without a spill, a finished producer
+//or a wake(), so announcements and timeouts are still checked
+static std::chrono::milliseconds control_wait(const Timer& total_timer,
+                                              uint64_t timeout)
+{
+  double wait = THREAD_CLOSE_WAIT_TIME_MS;
+  if (timeout)
+    wait = std::min(wait, std::max(0.0, timeout * 1000.0 - total_timer.ms()));
+  return std::chrono::milliseconds(static_cast<int64_t>(std::ceil(wait)));
+}
+
+static double ms_between(hr_time_t from, hr_time_t to)
+{
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
 Engine::Engine()
 {
   SettingMeta e0 {"ProfileDescr", SettingType::text, "Profile description"};
@@ -23,6 +43,45 @@ Engine::Engine()
   e2.set_val("min", 1);
   setting_definitions_[e2.id()] = e2;
 
+  SettingMeta e3 {"MergeByEventTime", SettingType::boolean, "Merge streams by native time"};
+  setting_definitions_[e3.id()] = e3;
+
+  SettingMeta e4 {"MaxLateness", SettingType::integer, "Maximum lateness (native time)"};
+  e4.set_val("min", 0);
+  e4.set_val("units", "ms");
+  setting_definitions_[e4.id()] = e4;
+
+  SettingMeta e11 {"MaxHold", SettingType::integer, "Maximum hold (wall clock)"};
+  e11.set_val("min", 0);
+  e11.set_val("units", "ms");
+  setting_definitions_[e11.id()] = e11;
+
+  SettingMeta e5 {"MaxReorder", SettingType::integer, "Maximum spills held per stream"};
+  e5.set_val("min", 1);
+  setting_definitions_[e5.id()] = e5;
+
+  SettingMeta e6 {"MaxChunkEvents", SettingType::integer, "Maximum events per consumer lock (0 = whole spill)"};
+  e6.set_val("min", 0);
+  setting_definitions_[e6.id()] = e6;
+
+  SettingMeta e7 {"ListDirectory", SettingType::text, "Record list mode to (empty = keep in memory)"};
+  e7.set_flag("directory");
+  setting_definitions_[e7.id()] = e7;
+
+  SettingMeta e8 {"ListRotateSize", SettingType::integer, "New list file after (0 = never)"};
+  e8.set_val("min", 0);
+  e8.set_val("units", "MB");
+  setting_definitions_[e8.id()] = e8;
+
+  SettingMeta e9 {"ListRotateTime", SettingType::integer, "New list file after (0 = never)"};
+  e9.set_val("min", 0);
+  e9.set_val("units", "s");
+  setting_definitions_[e9.id()] = e9;
+
+  SettingMeta e10 {"ListTailSpills", SettingType::integer, "Recorded spills kept for preview"};
+  e10.set_val("min", 0);
+  setting_definitions_[e10.id()] = e10;
+
 //  settings_ = default_settings();
 }
 
@@ -32,6 +91,15 @@ Setting Engine::default_settings()
   ret.branches.add(Setting::text("ProfileDescr", "(no description)"));
   ret.branches.add(SettingMeta("DropPackets", SettingType::menu));
   ret.branches.add(SettingMeta("MaxPackets", SettingType::integer));
+  ret.branches.add(SettingMeta("MergeByEventTime", SettingType::boolean));
+  ret.branches.add(SettingMeta("MaxLateness", SettingType::integer));
+  ret.branches.add(SettingMeta("MaxHold", SettingType::integer));
+  ret.branches.add(SettingMeta("MaxReorder", SettingType::integer));
+  ret.branches.add(SettingMeta("MaxChunkEvents", SettingType::integer));
+  ret.branches.add(SettingMeta("ListDirectory", SettingType::text));
+  ret.branches.add(SettingMeta("ListRotateSize", SettingType::integer));
+  ret.branches.add(SettingMeta("ListRotateTime", SettingType::integer));
+  ret.branches.add(SettingMeta("ListTailSpills", SettingType::integer));
   return ret;
 }
 
@@ -110,6 +178,17 @@ Setting Engine::settings() const
   return settings_;
 }
 
+static void add_latency_manifest(const std::string& stream_id, Setting& stats)
+{
+  for (auto stage : {"_enqueue", "_residency", "_processing"})
+    for (auto stat : {"_p50", "_p99", "_max"})
+    {
+      SettingMeta m(stream_id + stage + stat, SettingType::integer);
+      m.set_val("units", "us");
+      stats.branches.add(Setting(m));
+    }
+}
+
 StreamManifest Engine::stream_manifest() const
 {
   UNIQUE_LOCK_EVENTUALLY_ST
@@ -124,7 +203,14 @@ StreamManifest Engine::stream_manifest() const
     ret["engine"].stats.branches.add(SettingMeta("queue_size", SettingType::integer));
     ret["engine"].stats.branches.add(SettingMeta("dropped_spills", SettingType::integer));
     ret["engine"].stats.branches.add(SettingMeta("dropped_events", SettingType::integer));
+    ret["engine"].stats.branches.add(SettingMeta("late_spills", SettingType::integer));
+    ret["engine"].stats.branches.add(SettingMeta("forced_spills", SettingType::integer));
+    ret["engine"].stats.branches.add(SettingMeta("spill_pool_hits", SettingType::integer));
+    ret["engine"].stats.branches.add(SettingMeta("spill_pool_misses", SettingType::integer));
   }
+  for (auto& m : ret)
+    if (m.first != "engine")
+      add_latency_manifest(m.first, ret["engine"].stats);
   return ret;
 }
 
@@ -155,6 +241,51 @@ void Engine::_read_settings_bulk()
       set.set_number(max_packets_);
       //set.enable_if_flag(drop_packets_, "");
     }
+    else if (set.id() == "MergeByEventTime")
+    {
+      set.enrich(setting_definitions_);
+      set.set_bool(merge_by_event_time_);
+    }
+    else if (set.id() == "MaxLateness")
+    {
+      set.enrich(setting_definitions_);
+      set.set_number(max_lateness_ms_);
+    }
+    else if (set.id() == "MaxHold")
+    {
+      set.enrich(setting_definitions_);
+      set.set_number(max_hold_ms_);
+    }
+    else if (set.id() == "MaxReorder")
+    {
+      set.enrich(setting_definitions_);
+      set.set_number(max_reorder_);
+    }
+    else if (set.id() == "MaxChunkEvents")
+    {
+      set.enrich(setting_definitions_);
+      set.set_number(max_chunk_events_);
+    }
+    else if (set.id() == "ListDirectory")
+    {
+      set.enrich(setting_definitions_);
+      set.set_text(list_directory_);
+    }
+    else if (set.id() == "ListRotateSize")
+    {
+      set.enrich(setting_definitions_);
+      set.set_number(list_rotate_mb_);
+    }
+    else if (set.id() == "ListRotateTime")
+    {
+      set.enrich(setting_definitions_);
+      set.set_number(list_rotate_s_);
+    }
+    else if (set.id() == "ListTailSpills")
+    {
+      set.enrich(setting_definitions_);
+      set.set_number(list_tail_spills_);
+    }
     else if (!setting_definitions_.count(set.id()))
     {
       std::string name = set.get_text();
@@ -179,6 +310,42 @@ void Engine::_write_settings_bulk()
     {
       max_packets_ = set.get_number();
     }
+    else if (set.id() == "MergeByEventTime")
+    {
+      merge_by_event_time_ = set.get_bool();
+    }
+    else if (set.id() == "MaxLateness")
+    {
+      max_lateness_ms_ = set.get_number();
+    }
+    else if (set.id() == "MaxHold")
+    {
+      max_hold_ms_ = set.get_number();
+    }
+    else if (set.id() == "MaxReorder")
+    {
+      max_reorder_ = set.get_number();
+    }
+    else if (set.id() == "MaxChunkEvents")
+    {
+      max_chunk_events_ = set.get_number();
+    }
+    else if (set.id() == "ListDirectory")
+    {
+      list_directory_ = set.get_text();
+    }
+    else if (set.id() == "ListRotateSize")
+    {
+      list_rotate_mb_ = set.get_number();
+    }
+    else if (set.id() == "ListRotateTime")
+    {
+      list_rotate_s_ = set.get_number();
+    }
+    else if (set.id() == "ListTailSpills")
+    {
+      list_tail_spills_ = set.get_number();
+    }
     else if (!setting_definitions_.count(set.id()))
     {
       std::string name = set.get_text();
@@ -263,6 +430,42 @@ void Engine::_get_all_settings()
   _read_settings_bulk();
 }
 
+void Engine::wake()
+{
+  std::unique_lock<std::mutex> lock(control_mutex_);
+  if (active_queue_)
+    active_queue_->notify();
+}
+
+RunTurnover Engine::last_turnover() const
+{
+  std::unique_lock<std::mutex> lock(control_mutex_);
+  return last_turnover_;
+}
+
+void Engine::control_queue(SpillQueue queue)
+{
+  std::unique_lock<std::mutex> lock(control_mutex_);
+  active_queue_ = queue;
+}
+
+void Engine::report_turnover(const std::string& who, hr_time_t started,
+                             hr_time_t first_spill, hr_time_t stop_requested)
+{
+  RunTurnover turnover;
+  if (first_spill != hr_time_t())
+    turnover.start_to_first_spill_ms = ms_between(started, first_spill);
+  if (stop_requested != hr_time_t())
+    turnover.stop_to_drained_ms = ms_between(stop_requested,
+                                             std::chrono::system_clock::now());
+  {
+    std::unique_lock<std::mutex> lock(control_mutex_);
+    last_turnover_ = turnover;
+  }
+  INFO("<Engine::{}> Start to first spill: {} ms  Stop to drained: {} ms", who,
+       turnover.start_to_first_spill_ms, turnover.stop_to_drained_ms);
+}
+
 void Engine::acquire(ProjectPtr project, Interruptor &interruptor, uint64_t timeout)
 {
   UNIQUE_LOCK_EVENTUALLY_ST
@@ -287,6 +490,10 @@ void Engine::acquire(ProjectPtr project, Interruptor &interruptor, uint64_t time
   double secs_between_announcements = 5;
 
   SpillMultiqueue parsed_queue(drop_packets_, max_packets_);
+  if (merge_by_event_time_)
+    parsed_queue.merge_by_event_time(max_lateness_ms_ * 1000000.0,
+                                     std::chrono::milliseconds(max_hold_ms_),
+                                     max_reorder_);
 
   auto builder = std::thread(&Engine::builder_naive, this, &parsed_queue, project);
 
@@ -297,15 +504,21 @@ void Engine::acquire(ProjectPtr project, Interruptor &interruptor, uint64_t time
 //  spill->detectors = detectors_;
   parsed_queue.enqueue(spill);
 
+  control_queue(&parsed_queue);
+  hr_time_t started = std::chrono::system_clock::now();
+  hr_time_t stop_requested;
+
   if (!daq_start(&parsed_queue))
     ERR("<Engine> Failed to start device daq threads");
 
   Timer total_timer(static_cast<double>(timeout), true);
   Timer announcement_timer(secs_between_announcements, true);
 
+  //taken before checking on producers, so a finish in between still wakes us
+  uint64_t seen = parsed_queue.activity();
   while (daq_running())
   {
-    Timer::Timer::wait_ms(THREAD_CLOSE_WAIT_TIME_MS);
+    parsed_queue.wait_activity(seen, control_wait(total_timer, timeout));
     if (announcement_timer.timeout())
     {
       if (timeout > 0)
@@ -320,23 +533,26 @@ void Engine::acquire(ProjectPtr project, Interruptor &interruptor, uint64_t time
     }
     if (interruptor.load() || (timeout && total_timer.timeout()))
     {
+      if (stop_requested == hr_time_t())
+        stop_requested = std::chrono::system_clock::now();
       if (!daq_stop())
         ERR("<Engine> Failed to stop device daq threads");
     }
   }
+  if (stop_requested == hr_time_t())
+    stop_requested = std::chrono::system_clock::now();
 
   spill = std::make_shared<Spill>();
   _get_all_settings();
   spill->state = settings_;
   parsed_queue.enqueue(spill);
 
-  Timer::Timer::wait_ms(THREAD_CLOSE_WAIT_TIME_MS);
-  while (parsed_queue.size() > 0)
-    Timer::Timer::wait_ms(THREAD_CLOSE_WAIT_TIME_MS);
+  parsed_queue.wait_empty();
   parsed_queue.stop();
-  Timer::Timer::wait_ms(THREAD_CLOSE_WAIT_TIME_MS);
-
   builder.join();
+  control_queue(nullptr);
+
+  report_turnover("acquire", started, parsed_queue.first_spill(), stop_requested);
   INFO("<Engine::acquire> Acquisition finished"
        "\n   dropped spills: {} \n   dropped events: {}",
        parsed_queue.dropped_spills(), parsed_queue.dropped_events());
@@ -360,15 +576,53 @@ ListData Engine::acquire_list(Interruptor& interruptor, uint64_t timeout)
   SpillPtr spill;
   ListData result;
 
+  //streams to disk if a directory is given, otherwise keeps all in memory
+  ListRecorder recorder;
+  if (!list_directory_.empty())
+  {
+    std::string prefix = "list_" + to_iso_extended(std::chrono::system_clock::now());
+    std::replace(prefix.begin(), prefix.end(), ':', '-');
+    recorder.rotate_bytes = list_rotate_mb_ * 1000000;
+    recorder.rotate_seconds = list_rotate_s_;
+    recorder.tail_spills = list_tail_spills_;
+    try
+    {
+      recorder.open(list_directory_, prefix);
+    }
+    catch (std::exception& e)
+    {
+      ERR("<Engine> {}", e.what());
+      return ListData();
+    }
+  }
+
+  auto keep = [&](SpillPtr s) -> bool
+  {
+    if (!recorder.is_open())
+    {
+      result.push_back(s);
+      return true;
+    }
+    return recorder.record(s);
+  };
+
   double secs_between_announcements = 5;
 
   spill = std::make_shared<Spill>();
   _get_all_settings();
   spill->state = settings_;
 //  spill->detectors = detectors_;
-  result.push_back(spill);
+  keep(spill);
 
   SpillMultiqueue parsed_queue(drop_packets_, max_packets_);
+  if (merge_by_event_time_)
+    parsed_queue.merge_by_event_time(max_lateness_ms_ * 1000000.0,
+                                     std::chrono::milliseconds(max_hold_ms_),
+                                     max_reorder_);
+
+  control_queue(&parsed_queue);
+  hr_time_t started = std::chrono::system_clock::now();
+  hr_time_t stop_requested;
 
   if (!daq_start(&parsed_queue))
     ERR("<Engine> Failed to start device daq threads");
@@ -376,9 +630,20 @@ ListData Engine::acquire_list(Interruptor& interruptor, uint64_t timeout)
   Timer total_timer(static_cast<double>(timeout), true);
   Timer announcement_timer(secs_between_announcements, true);
 
+  bool failed {false};
+  uint64_t seen = parsed_queue.activity();
   while (daq_running())
   {
-    Timer::Timer::wait_ms(THREAD_CLOSE_WAIT_TIME_MS);
+    parsed_queue.wait_activity(seen, control_wait(total_timer, timeout));
+    //drain as we go so memory stays bounded
+    //spills held back for merging wait for a later pass
+    while (recorder.is_open() && !failed)
+    {
+      auto next = parsed_queue.try_dequeue();
+      if (!next)
+        break;
+      failed = !keep(next);
+    }
     if (announcement_timer.timeout())
     {
       INFO("  RUNNING Elapsed: {}  ETA: {}  Dropped spills: {}  Dropped events: {}",
@@ -386,29 +651,48 @@ ListData Engine::acquire_list(Interruptor& interruptor, uint64_t timeout)
           parsed_queue.dropped_spills(), parsed_queue.dropped_events());
       announcement_timer.restart();
     }
-    if (interruptor.load() || (timeout && total_timer.timeout()))
+    if (failed || interruptor.load() || (timeout && total_timer.timeout()))
     {
+      if (stop_requested == hr_time_t())
+        stop_requested = std::chrono::system_clock::now();
       if (!daq_stop())
         ERR( "<Engine> Failed to stop device daq threads");
     }
   }
+  if (stop_requested == hr_time_t())
+    stop_requested = std::chrono::system_clock::now();
 
   spill = std::make_shared<Spill>();
   _get_all_settings();
   spill->state = settings_;
   parsed_queue.enqueue(spill);
 
-  Timer::Timer::wait_ms(THREAD_CLOSE_WAIT_TIME_MS);
-
+  //producers are done, everything they made is already queued
   while (parsed_queue.size() > 0)
-    result.push_back(SpillPtr(parsed_queue.dequeue()));
+  {
+    spill = parsed_queue.dequeue();
+    if (!failed)
+      failed = !keep(spill);
+  }
 
   parsed_queue.stop();
+  control_queue(nullptr);
 
   INFO("<Engine::acquire_list> Acquisition finished"
        "\n   dropped spills: {}\n   dropped events: {}",
        parsed_queue.dropped_spills(), parsed_queue.dropped_events());
 
+  if (recorder.is_open())
+  {
+    for (const auto& f : recorder.files())
+      INFO("<Engine::acquire_list> Recorded {}", f);
+    INFO("<Engine::acquire_list> {} spills, {} bytes written",
+         recorder.spills_written(), recorder.bytes_written());
+    recorder.close();
+    result = recorder.tail();
+  }
+
+  report_turnover("acquire_list", started, parsed_queue.first_spill(), stop_requested);
   return result;
 }
 
@@ -426,6 +710,11 @@ void Engine::builder_naive(SpillQueue data_queue,
   spill->state.branches.add_a(Setting::integer("queue_size", data_queue->size()));
   spill->state.branches.add_a(Setting::integer("dropped_spills", data_queue->dropped_spills()));
   spill->state.branches.add_a(Setting::integer("dropped_events", data_queue->dropped_events()));
+  spill->state.branches.add_a(Setting::integer("late_spills", data_queue->late_spills()));
+  spill->state.branches.add_a(Setting::integer("forced_spills", data_queue->forced_spills()));
+  spill->state.branches.add_a(Setting::integer("spill_pool_hits", SpillPool::singleton().hits()));
+  spill->state.branches.add_a(Setting::integer("spill_pool_misses", SpillPool::singleton().misses()));
+  data_queue->latency_stats(spill->state);
   project->add_spill(spill);
 
   while (true)
@@ -434,14 +723,21 @@ void Engine::builder_naive(SpillQueue data_queue,
     if (spill == nullptr)
       break;
     Timer presort_timer(true);
+    auto dequeued = std::chrono::system_clock::now();
     presort_cycles++;
     presort_events += spill->events.size();
-    project->add_spill(spill);
+    project->add_spill(spill, max_chunk_events_);
+    data_queue->processed(spill->stream_id, dequeued);
 
-    spill = std::make_shared<Spill>("engine", Spill::Type::running);
+    spill = SpillPool::singleton().get("engine", Spill::Type::running);
     spill->state.branches.add_a(Setting::integer("queue_size", data_queue->size()));
     spill->state.branches.add_a(Setting::integer("dropped_spills", data_queue->dropped_spills()));
     spill->state.branches.add_a(Setting::integer("dropped_events", data_queue->dropped_events()));
+    spill->state.branches.add_a(Setting::integer("late_spills", data_queue->late_spills()));
+    spill->state.branches.add_a(Setting::integer("forced_spills", data_queue->forced_spills()));
+    spill->state.branches.add_a(Setting::integer("spill_pool_hits", SpillPool::singleton().hits()));
+    spill->state.branches.add_a(Setting::integer("spill_pool_misses", SpillPool::singleton().misses()));
+    data_queue->latency_stats(spill->state);
     project->add_spill(spill);
 
     time += presort_timer.s();
@@ -451,6 +747,11 @@ void Engine::builder_naive(SpillQueue data_queue,
   spill->state.branches.add_a(Setting::integer("queue_size", data_queue->size()));
   spill->state.branches.add_a(Setting::integer("dropped_spills", data_queue->dropped_spills()));
   spill->state.branches.add_a(Setting::integer("dropped_events", data_queue->dropped_events()));
+  spill->state.branches.add_a(Setting::integer("late_spills", data_queue->late_spills()));
+  spill->state.branches.add_a(Setting::integer("forced_spills", data_queue->forced_spills()));
+  spill->state.branches.add_a(Setting::integer("spill_pool_hits", SpillPool::singleton().hits()));
+  spill->state.branches.add_a(Setting::integer("spill_pool_misses", SpillPool::singleton().misses()));
+  data_queue->latency_stats(spill->state);
   project->add_spill(spill);
 
   Timer presort_timer(true);
@@ -10,6 +10,13 @@ namespace DAQuiri {
 
 using Interruptor = std::atomic<bool>;
 
+// how quickly the last run got going and wound down, negative if it did not
+struct RunTurnover
+{
+  double start_to_first_spill_ms {-1};
+  double stop_to_drained_ms {-1};
+};
+
 class Engine
 {
   public:
@@ -31,6 +38,11 @@ class Engine
     void acquire(ProjectPtr project, Interruptor& interruptor,
                  uint64_t timeout);
 
+    // call after setting the interruptor, so a running acquisition
+    // notices right away
+    void wake();
+    RunTurnover last_turnover() const;
+
     /////SETTINGS/////
     Setting settings() const;
     void settings(const Setting&);
@@ -41,6 +53,11 @@ class Engine
   private:
     mutable mutex_st mutex_;
 
+    // held for the whole acquisition by mutex_, so wake() needs its own
+    mutable std::mutex control_mutex_;
+    SpillQueue active_queue_ {nullptr};
+    RunTurnover last_turnover_;
+
     ProducerStatus aggregate_status_{ProducerStatus(0)};
 
     std::map<std::string, ProducerPtr> producers_;
@@ -49,6 +66,15 @@ class Engine
     // {SettingMeta("Engine", SettingType::stem)};
     int drop_packets_{0};
     size_t max_packets_{100};
+    bool merge_by_event_time_{false};
+    uint64_t max_lateness_ms_{1000};
+    uint64_t max_hold_ms_{1000};
+    size_t max_reorder_{100};
+    size_t max_chunk_events_{100000};
+    std::string list_directory_;
+    uint64_t list_rotate_mb_{0};
+    uint64_t list_rotate_s_{0};
+    size_t list_tail_spills_{100};
 
     std::map<std::string, SettingMeta> setting_definitions_;
 
@@ -65,6 +91,10 @@ class Engine
     bool daq_stop();
     bool daq_running() const;
 
+    void control_queue(SpillQueue);
+    void report_turnover(const std::string& who, hr_time_t started,
+                         hr_time_t first_spill, hr_time_t stop_requested);
+
     //threads
     void builder_naive(SpillQueue data_queue,
                        ProjectPtr project);
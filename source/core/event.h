@@ -15,17 +15,11 @@ private:
 public:
   inline Event() {}
 
+  //traces start out empty, producers size them to the actual payload
   inline Event(const EventModel &model)
     : values_ (model.values)
-  {
-    for (auto t : model.traces)
-    {
-      size_t product = 1;
-      for (auto d : t)
-        product *= d;
-      traces_.push_back(std::vector<uint32_t>(product, 0));
-    }
-  }
+    , traces_ (model.traces.size())
+  {}
 
   //Accessors
   inline uint64_t timestamp() const
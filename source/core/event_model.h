@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <map>
+#include <memory>
+#include <atomic>
 #include <core/time_stamp.h>
 
 //might want to encapsulate member vars?
@@ -18,6 +20,7 @@ public:
   std::vector<std::string>      value_names;
   std::map<std::string, size_t> name_to_val;
 
+  //declared (maximum) dimensions, events carry only as much as they have
   std::vector<std::vector<size_t>> traces;
   std::vector<std::string>         trace_names;
   std::map<std::string, size_t>    name_to_trace;
@@ -102,5 +105,50 @@ inline void from_json(const json& j, EventModel& t)
     }
 }
 
+//Immutable, refcounted event model shared by all spills of a stream.
+//Copying is a pointer copy. Consumers may cache anything they resolved
+//from the model for as long as id() stays the same.
+class SharedEventModel
+{
+ public:
+  inline SharedEventModel()
+    : model_(empty_model())
+    , id_(0)
+  {}
+
+  inline SharedEventModel(EventModel model)
+    : model_(std::make_shared<EventModel>(std::move(model)))
+    , id_(next_id())
+  {}
+
+  inline const EventModel& operator*() const { return *model_; }
+  inline const EventModel* operator->() const { return model_.get(); }
+  inline uint64_t id() const { return id_; }
+
+  //detaches from other holders, the model gets a new id
+  inline EventModel& edit()
+  {
+    if (model_.use_count() > 1)
+      model_ = std::make_shared<EventModel>(*model_);
+    id_ = next_id();
+    return *model_;
+  }
+
+ private:
+  std::shared_ptr<EventModel> model_;
+  uint64_t id_;
+
+  static inline uint64_t next_id()
+  {
+    static std::atomic<uint64_t> counter {0};
+    return ++counter;
+  }
+
+  static inline const std::shared_ptr<EventModel>& empty_model()
+  {
+    static const std::shared_ptr<EventModel> empty {std::make_shared<EventModel>()};
+    return empty;
+  }
+};
 
 }
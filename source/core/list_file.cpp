@@ -0,0 +1,290 @@
+#include <core/list_file.h>
+#include <core/util/logger.h>
+#include <cstring>
+
+namespace DAQuiri
+{
+
+static const char k_list_magic[8] = {'D', 'A', 'Q', 'L', 'I', 'S', 'T', '1'};
+
+ListRecorder::~ListRecorder()
+{
+  close();
+}
+
+void ListRecorder::open(std::string directory, std::string prefix)
+{
+  close();
+  directory_ = directory;
+  prefix_ = prefix;
+  files_.clear();
+  tail_.clear();
+  spills_ = 0;
+  bytes_ = 0;
+  next_file();
+}
+
+void ListRecorder::close()
+{
+  if (file_.is_open())
+    file_.close();
+}
+
+bool ListRecorder::is_open() const
+{
+  return file_.is_open();
+}
+
+static std::string list_file_name(std::string prefix, size_t number)
+{
+  std::string n = std::to_string(number);
+  if (n.size() < 4)
+    n = std::string(4 - n.size(), '0') + n;
+  return prefix + "_" + n + ".daqlist";
+}
+
+void ListRecorder::next_file()
+{
+  close();
+
+  std::string path = list_file_name(prefix_, files_.size());
+  if (!directory_.empty())
+    path = directory_ + "/" + path;
+
+  file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file_.is_open())
+    throw std::runtime_error("<ListRecorder> Could not open " + path);
+
+  files_.push_back(path);
+  file_bytes_ = 0;
+  file_spills_ = 0;
+  file_opened_ = std::chrono::system_clock::now();
+  models_.clear();
+  write(k_list_magic, sizeof(k_list_magic));
+}
+
+void ListRecorder::write(const void* data, size_t size)
+{
+  file_.write(reinterpret_cast<const char*>(data), size);
+  file_bytes_ += size;
+  bytes_ += size;
+}
+
+bool ListRecorder::record(SpillPtr spill)
+{
+  if (!spill || !file_.is_open())
+    return false;
+
+  //every file gets at least one spill
+  bool rotate = (rotate_bytes && (file_bytes_ >= rotate_bytes));
+  if (rotate_seconds)
+    rotate |= (std::chrono::system_clock::now() - file_opened_)
+        >= std::chrono::seconds(rotate_seconds);
+  if (rotate && file_spills_)
+  {
+    try
+    {
+      next_file();
+    }
+    catch (std::exception& e)
+    {
+      ERR("{}", e.what());
+      return false;
+    }
+  }
+
+  json j;
+  j["type"] = Spill::to_str(spill->type);
+  j["stream_id"] = spill->stream_id;
+  j["time"] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      spill->time.time_since_epoch()).count();
+  if (spill->state)
+    j["state"] = spill->state;
+
+  auto model_id = spill->event_model.id();
+  auto known = models_.find(spill->stream_id);
+  if ((known == models_.end()) || (known->second != model_id))
+  {
+    j["event_model"] = *spill->event_model;
+    models_[spill->stream_id] = model_id;
+  }
+
+  std::string header = j.dump();
+  write(static_cast<uint32_t>(header.size()));
+  write(header.data(), header.size());
+
+  write(static_cast<uint64_t>(spill->events.size()));
+  for (const auto& e : spill->events)
+  {
+    write(e.timestamp());
+    write(static_cast<uint32_t>(e.value_count()));
+    for (size_t i = 0; i < e.value_count(); ++i)
+      write(e.value(i));
+    write(static_cast<uint32_t>(e.trace_count()));
+    for (size_t i = 0; i < e.trace_count(); ++i)
+    {
+      const auto& t = e.trace(i);
+      write(static_cast<uint32_t>(t.size()));
+      write(t.data(), t.size() * sizeof(uint32_t));
+    }
+  }
+
+  write(static_cast<uint64_t>(spill->raw.size()));
+  write(spill->raw.data(), spill->raw.size());
+
+  if (!file_.good())
+  {
+    ERR("<ListRecorder> Failed writing to {}", files_.back());
+    return false;
+  }
+
+  spills_++;
+  file_spills_++;
+  if (tail_spills)
+  {
+    tail_.push_back(spill);
+    while (tail_.size() > tail_spills)
+      tail_.pop_front();
+  }
+  return true;
+}
+
+ListData ListRecorder::tail() const
+{
+  return ListData(tail_.begin(), tail_.end());
+}
+
+std::vector<std::string> ListRecorder::files() const
+{
+  return files_;
+}
+
+uint64_t ListRecorder::spills_written() const
+{
+  return spills_;
+}
+
+uint64_t ListRecorder::bytes_written() const
+{
+  return bytes_;
+}
+
+ListReader::ListReader(std::string path)
+  : path_(path)
+{
+  file_.open(path, std::ios::in | std::ios::binary);
+  char magic[sizeof(k_list_magic)];
+  if (!file_.is_open() || !read(magic, sizeof(magic))
+      || std::memcmp(magic, k_list_magic, sizeof(magic)))
+    throw std::runtime_error("<ListReader> Not a list mode file: " + path);
+}
+
+std::vector<std::string> ListReader::sequence(std::string first)
+{
+  std::vector<std::string> ret {first};
+
+  // <prefix>_<number>.daqlist
+  std::string extension = ".daqlist";
+  auto underscore = first.rfind('_');
+  if ((underscore == std::string::npos) || (first.size() < extension.size())
+      || (first.compare(first.size() - extension.size(), extension.size(), extension)))
+    return ret;
+  std::string number = first.substr(underscore + 1,
+                                    first.size() - extension.size() - underscore - 1);
+  if (number.empty() ||
+      (number.find_first_not_of("0123456789") != std::string::npos))
+    return ret;
+
+  std::string prefix = first.substr(0, underscore);
+  for (size_t i = std::stoul(number) + 1; ; ++i)
+  {
+    auto next = list_file_name(prefix, i);
+    if (!std::ifstream(next).good())
+      break;
+    ret.push_back(next);
+  }
+  return ret;
+}
+
+bool ListReader::read(void* data, size_t size)
+{
+  file_.read(reinterpret_cast<char*>(data), size);
+  return (static_cast<size_t>(file_.gcount()) == size);
+}
+
+SpillPtr ListReader::next()
+{
+  uint32_t header_size {0};
+  if (!read(header_size))
+    return nullptr;
+
+  try
+  {
+    std::string header(header_size, '\0');
+    uint64_t count {0};
+    if (!read(&header[0], header.size()) || !read(count))
+      throw std::runtime_error("truncated header");
+
+    json j = json::parse(header);
+    auto spill = std::make_shared<Spill>();
+    spill->type = Spill::from_str(j["type"]);
+    spill->stream_id = j["stream_id"];
+    spill->time = hr_time_t(std::chrono::duration_cast<hr_time_t::duration>(
+        std::chrono::nanoseconds(j["time"].get<int64_t>())));
+    if (j.count("state"))
+      spill->state = j["state"];
+    if (j.count("event_model"))
+      models_[spill->stream_id] = SharedEventModel(j["event_model"].get<EventModel>());
+    spill->event_model = models_[spill->stream_id];
+
+    if (count)
+      spill->events.reserve(count, Event(*spill->event_model));
+    std::vector<uint32_t> values;
+    for (uint64_t n = 0; n < count; ++n)
+    {
+      auto& e = spill->events.last();
+      uint64_t timestamp {0};
+      uint32_t size {0};
+      if (!read(timestamp) || !read(size))
+        throw std::runtime_error("truncated event");
+      e.set_time(timestamp);
+
+      values.resize(size);
+      if (!read(values.data(), size * sizeof(uint32_t)))
+        throw std::runtime_error("truncated event");
+      for (size_t i = 0; i < std::min(values.size(), e.value_count()); ++i)
+        e.set_value(i, values[i]);
+
+      uint32_t traces {0};
+      if (!read(traces))
+        throw std::runtime_error("truncated event");
+      for (uint32_t i = 0; i < traces; ++i)
+      {
+        if (!read(size))
+          throw std::runtime_error("truncated trace");
+        values.resize(size);
+        if (!read(values.data(), size * sizeof(uint32_t)))
+          throw std::runtime_error("truncated trace");
+        if (i < e.trace_count())
+          e.trace(i) = values;
+      }
+      ++spill->events;
+    }
+    spill->events.finalize();
+
+    uint64_t raw {0};
+    if (!read(raw))
+      throw std::runtime_error("truncated raw data");
+    spill->raw.resize(raw);
+    if (!read(spill->raw.data(), raw))
+      throw std::runtime_error("truncated raw data");
+
+    return spill;
+  }
+  catch (...)
+  {
+    std::throw_with_nested(std::runtime_error("<ListReader> Bad spill in " + path_));
+  }
+}
+
+}
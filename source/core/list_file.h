@@ -0,0 +1,89 @@
+#pragma once
+
+#include <core/spill.h>
+#include <deque>
+#include <fstream>
+
+namespace DAQuiri
+{
+
+// List mode files hold a sequence of spills:
+//   "DAQLIST1"
+//   per spill: u32 header size, json header,
+//              u64 event count, events, u64 raw size, raw bytes
+//   per event: u64 timestamp, u32 value count, values,
+//              u32 trace count, per trace u32 size and samples
+// The header carries stream, type, time (ns since epoch) and state; the
+// event model only when it first appears for a stream in that file.
+// Integers are written in host byte order.
+
+class ListRecorder
+{
+ public:
+  ListRecorder() {}
+  ~ListRecorder();
+
+  // writes <directory>/<prefix>_0000.daqlist, _0001, ...
+  void open(std::string directory, std::string prefix);
+  void close();
+  bool is_open() const;
+
+  // start a new file past either limit, 0 = never
+  uint64_t rotate_bytes {0};
+  uint64_t rotate_seconds {0};
+
+  // most recent spills kept in memory for preview
+  size_t tail_spills {100};
+
+  // false if the spill could not be written
+  bool record(SpillPtr spill);
+
+  ListData tail() const;
+  std::vector<std::string> files() const;
+  uint64_t spills_written() const;
+  uint64_t bytes_written() const;
+
+ private:
+  std::string directory_;
+  std::string prefix_;
+  std::ofstream file_;
+  uint64_t file_bytes_ {0};
+  uint64_t file_spills_ {0};
+  hr_time_t file_opened_;
+
+  // event model last written per stream, in the current file
+  std::map<std::string, uint64_t> models_;
+
+  std::deque<SpillPtr> tail_;
+  std::vector<std::string> files_;
+  uint64_t spills_ {0};
+  uint64_t bytes_ {0};
+
+  void next_file();
+  void write(const void* data, size_t size);
+  template<typename T>
+  void write(const T& val) { write(&val, sizeof(T)); }
+};
+
+class ListReader
+{
+ public:
+  explicit ListReader(std::string path);
+
+  // the given file and the ones a ListRecorder rotated to after it
+  static std::vector<std::string> sequence(std::string first);
+
+  // nullptr at end of file, throws if a spill is cut short
+  SpillPtr next();
+
+ private:
+  std::string path_;
+  std::ifstream file_;
+  std::map<std::string, SharedEventModel> models_;
+
+  bool read(void* data, size_t size);
+  template<typename T>
+  bool read(T& val) { return read(&val, sizeof(T)); }
+};
+
+}
@@ -0,0 +1,85 @@
+#include <core/plugin/setting_index.h>
+#include <stdexcept>
+
+namespace DAQuiri {
+
+SettingIndex::SettingIndex(Setting& root)
+{
+  rebuild(root);
+}
+
+void SettingIndex::rebuild(Setting& root)
+{
+  clear();
+  add(root);
+}
+
+void SettingIndex::clear()
+{
+  nodes_.clear();
+  size_ = 0;
+}
+
+size_t SettingIndex::size() const
+{
+  return size_;
+}
+
+void SettingIndex::add(Setting& node)
+{
+  size_t preorder = size_++;
+  //children first, as in Setting::find_dfs
+  for (auto& q : node.branches)
+    add(q);
+  nodes_[node.id()].push_back({&node, preorder});
+}
+
+const std::vector<SettingIndex::Node>*
+SettingIndex::candidates(const Setting& address, Match m) const
+{
+  if (!(m & Match::id))
+    throw std::runtime_error("<SettingIndex> lookup requires Match::id");
+  auto it = nodes_.find(address.id());
+  if (it == nodes_.end())
+    return nullptr;
+  return &it->second;
+}
+
+Setting* SettingIndex::find(const Setting& address, Match m) const
+{
+  auto c = candidates(address, m);
+  if (!c)
+    return nullptr;
+  for (const auto& n : *c)
+    if (n.setting->compare(address, m))
+      return n.setting;
+  return nullptr;
+}
+
+Setting* SettingIndex::find_for_set(const Setting& address, Match m) const
+{
+  auto c = candidates(address, m);
+  if (!c)
+    return nullptr;
+  const Node* ret {nullptr};
+  for (const auto& n : *c)
+    if ((!ret || (n.preorder < ret->preorder))
+        && n.setting->compare(address, m))
+      ret = &n;
+  return ret ? ret->setting : nullptr;
+}
+
+std::vector<Setting*> SettingIndex::find_all(const Setting& address,
+                                             Match m) const
+{
+  std::vector<Setting*> ret;
+  auto c = candidates(address, m);
+  if (!c)
+    return ret;
+  for (const auto& n : *c)
+    if (n.setting->compare(address, m))
+      ret.push_back(n.setting);
+  return ret;
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <core/plugin/setting.h>
+#include <unordered_map>
+#include <vector>
+
+namespace DAQuiri {
+
+// id -> node lookup over a Setting tree. Node addresses stay valid until
+// the tree changes shape (replace, erase, cull, assignment); rebuild after
+// any of those. Values may change freely.
+class SettingIndex
+{
+  public:
+    SettingIndex() {}
+    explicit SettingIndex(Setting& root);
+
+    void rebuild(Setting& root);
+    void clear();
+    size_t size() const;
+
+    // m must include Match::id
+    // same node as Setting::find (children before parents)
+    Setting* find(const Setting& address, Match m = Match::id) const;
+    // same node as Setting::set and Setting::replace (parents first)
+    Setting* find_for_set(const Setting& address, Match m = Match::id) const;
+    std::vector<Setting*> find_all(const Setting& address,
+                                   Match m = Match::id) const;
+
+  private:
+    struct Node
+    {
+      Setting* setting;
+      size_t preorder;
+    };
+
+    // per id, in Setting::find order
+    std::unordered_map<std::string, std::vector<Node>> nodes_;
+    size_t size_ {0};
+
+    void add(Setting& node);
+    const std::vector<Node>* candidates(const Setting& address, Match m) const;
+};
+
+}
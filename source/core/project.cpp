@@ -3,12 +3,17 @@
 #include <core/util/logger.h>
 #include <core/util/h5json.h>
 #include <core/util/ascii_tree.h>
+#include <algorithm>
+#include <atomic>
 
 #include <build_time.h>
 
 
 namespace DAQuiri {
 
+//identifies a spill to consumers across its chunks, never reused
+static std::atomic<uint64_t> spill_sequence {0};
+
 Project::Project(const Project& other)
 {
   ready_ = true;
@@ -164,6 +169,36 @@ Container<ConsumerPtr> Project::get_consumers() const
   return consumers_;
 }
 
+std::string Project::profile_report() const
+{
+  std::vector<std::pair<ConsumerPtr, ConsumerProfile>> profiles;
+  for (const auto& c : get_consumers())
+    profiles.push_back({c, c->profile()});
+
+  std::sort(profiles.begin(), profiles.end(),
+            [](const std::pair<ConsumerPtr, ConsumerProfile>& a,
+               const std::pair<ConsumerPtr, ConsumerProfile>& b)
+            {
+              return a.second.total_ns() > b.second.total_ns();
+            });
+
+  std::stringstream ss;
+  ss << fmt::format("{:<24} {:<16} {:>8} {:>12} {:>12} {:>12} {:>10} {:>10} {:>10} {:>8}\n",
+                    "name", "type", "spills", "events", "accepted", "rejected",
+                    "pre_ms", "events_ms", "post_ms", "ns/event");
+  for (const auto& p : profiles)
+  {
+    const auto& pr = p.second;
+    auto md = p.first->metadata();
+    ss << fmt::format("{:<24} {:<16} {:>8} {:>12} {:>12} {:>12} {:>10.3f} {:>10.3f} {:>10.3f} {:>8.1f}\n",
+                      md.get_attribute("name").get_text(), md.type(),
+                      pr.spills, pr.events, pr.events_accepted, pr.events_rejected,
+                      pr.pre_ns * 1e-6, pr.events_ns * 1e-6, pr.post_ns * 1e-6,
+                      pr.events ? double(pr.events_ns) / double(pr.events) : 0.0);
+  }
+  return ss.str();
+}
+
 void Project::add_consumer(ConsumerPtr consumer)
 {
   UNIQUE_LOCK_EVENTUALLY
@@ -219,9 +254,107 @@ void Project::add_spill(SpillPtr one_spill)
 {
   UNIQUE_LOCK_EVENTUALLY
 
-  for (auto& q: consumers_)
-    q->push_spill(*one_spill);
+  one_spill->sequence = ++spill_sequence;
+  cache_.reset(one_spill.get());
+  for (auto& q: _route(one_spill->stream_id))
+    q->push_spill(*one_spill, 0, one_spill->events.size(), &cache_);
+  cache_.reset();
 
+  _spill_done(one_spill);
+}
+
+void Project::add_spill(SpillPtr one_spill, size_t chunk_events)
+{
+  size_t total = one_spill->events.size();
+  if (!chunk_events || (total <= chunk_events))
+  {
+    add_spill(one_spill);
+    return;
+  }
+
+  for (size_t begin = 0; begin < total; begin += chunk_events)
+  {
+    size_t end = std::min(total, begin + chunk_events);
+
+    UNIQUE_LOCK_EVENTUALLY
+
+    //shared results are extended chunk by chunk
+    if (begin == 0)
+    {
+      one_spill->sequence = ++spill_sequence;
+      cache_.reset(one_spill.get());
+    }
+    for (auto& q: _route(one_spill->stream_id))
+      q->push_spill(*one_spill, begin, end, &cache_);
+
+    if (end == total)
+    {
+      cache_.reset();
+      _spill_done(one_spill);
+    }
+    else
+    {
+      changed_ = true;
+      has_data_ = true;
+      ready_ = true;
+      cond_.notify_all();
+    }
+  }
+}
+
+const std::vector<ConsumerPtr>& Project::_route(const std::string& stream_id)
+{
+  //private, no lock needed
+  bool valid = (routed_.size() == consumers_.size());
+  auto r = routed_.begin();
+  for (auto q = consumers_.begin(); valid && (q != consumers_.end()); ++q, ++r)
+    valid = (r->first == *q)
+        && (!*q || (r->second == (*q)->attributes_generation()));
+  if (!valid)
+    _rebuild_routes();
+
+  auto it = routes_.find(stream_id);
+  if (it != routes_.end())
+    return it->second;
+  return unrouted_;
+}
+
+void Project::_rebuild_routes()
+{
+  //private, no lock needed
+  routed_.clear();
+  routes_.clear();
+  unrouted_.clear();
+
+  std::vector<std::pair<ConsumerPtr, std::set<std::string>>> interests;
+  for (auto& q : consumers_)
+  {
+    //generation first, so a change while reading streams forces a rebuild
+    routed_.push_back({q, q ? q->attributes_generation() : 0});
+    if (!q)
+      continue;
+    interests.push_back({q, q->streams()});
+    for (const auto& s : interests.back().second)
+      routes_[s];
+  }
+
+  //keep project order within each route
+  for (auto& i : interests)
+  {
+    if (i.second.empty())
+    {
+      unrouted_.push_back(i.first);
+      for (auto& r : routes_)
+        r.second.push_back(i.first);
+    }
+    else
+      for (const auto& s : i.second)
+        routes_[s].push_back(i.first);
+  }
+}
+
+void Project::_spill_done(SpillPtr one_spill)
+{
   if (save_spills_)
   {
     one_spill->raw.clear();
@@ -31,6 +31,8 @@ class Project
 
     // to consume data
     void add_spill(SpillPtr one_spill); // feeds events to all consumers
+    // same, but releasing locks every chunk_events events
+    void add_spill(SpillPtr one_spill, size_t chunk_events);
     void flush();
 
     // consumers access
@@ -42,6 +44,9 @@ class Project
     ConsumerPtr get_consumer(size_t idx);
     Container<ConsumerPtr> get_consumers() const;
 
+    // binning cost per consumer, most expensive first
+    std::string profile_report() const;
+
     // spill access
     void save_spills(bool);
     bool save_spills() const;
@@ -76,10 +81,22 @@ class Project
     bool changed_ {false};
     bool has_data_ {false};
 
+    // consumers interested in each stream, rebuilt when consumers_ or
+    // their attributes change; unrouted_ take streams nobody declared
+    std::vector<std::pair<ConsumerPtr, uint64_t>> routed_;
+    std::map<std::string, std::vector<ConsumerPtr>> routes_;
+    std::vector<ConsumerPtr> unrouted_;
+
+    // filter and value results of the spill being added, shared by consumers
+    SpillCache cache_;
+
     // helpers
     void _clear();
     void _save_metadata(std::string file_name);
     void _add_consumer(ConsumerPtr consumer);
+    void _spill_done(SpillPtr one_spill);
+    const std::vector<ConsumerPtr>& _route(const std::string& stream_id);
+    void _rebuild_routes();
 };
 
 }
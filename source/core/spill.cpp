@@ -51,7 +51,7 @@ std::string Spill::debug(std::string prepend) const
   ss << " @ " << to_iso_extended(time) << "\n";
 
   ss << prepend << k_branch_mid_B << "event model: "
-     << event_model.debug() << "\n";
+     << event_model->debug() << "\n";
 
   if (events.size())
     ss << prepend << k_branch_mid_B << "event_count=" << events.size() << "\n";
@@ -71,7 +71,7 @@ void to_json(json& j, const Spill& s)
   j["time"] = to_iso_extended(s.time);
 //  j["bytes_raw_data"] = data.size() * sizeof(char);
 //  j["number_of_events"] = events.size();
-  j["event_model"] = s.event_model;
+  j["event_model"] = *s.event_model;
 
   if (s.state)
     j["state"] = s.state;
@@ -82,7 +82,7 @@ void from_json(const json& j, Spill& s)
   s.type = Spill::from_str(j["type"]);
   s.stream_id = j["stream_id"];
   s.time = from_iso_extended(j["time"].get<std::string>());
-  s.event_model = j["event_model"];
+  s.event_model = j["event_model"].get<EventModel>();
 
   if (j.count("state"))
     s.state = j["state"];
@@ -28,7 +28,27 @@ class EventBuffer
   inline size_t size() const { return data_.size(); }
   inline bool empty() const { return data_.empty(); }
 
-  inline void reserve(size_t s, const Event& e) { data_.resize(s, e); }
+  inline void reserve(size_t s, const Event& e)
+  {
+    //reuse events (and their vectors) left over from a recycled buffer
+    if (data_.empty() && !spare_.empty())
+    {
+      data_.swap(spare_);
+      data_.resize(std::min(s, data_.size()));
+      for (auto& old : data_)
+        old = e;
+    }
+    data_.resize(s, e);
+  }
+
+  //empties the buffer but keeps event storage for the next reserve
+  inline void recycle()
+  {
+    if (!data_.empty())
+      spare_.swap(data_);
+    data_.clear();
+    idx_ = 0;
+  }
   inline Event& last() { return data_[idx_]; }
 
   inline EventBuffer& operator++()
@@ -49,6 +69,7 @@ class EventBuffer
 
  private:
   std::vector<Event> data_;
+  std::vector<Event> spare_;
   size_t idx_{0};
 };
 
@@ -68,8 +89,11 @@ class Spill
   hr_time_t time{std::chrono::system_clock::now()};
   Setting state;
 
+  // stamped by Project::add_spill, unique per push, 0 if never added
+  uint64_t sequence{0};
+
   std::vector<char> raw; // raw from device
-  EventModel event_model;
+  SharedEventModel event_model;
   EventBuffer events;
 
  public:
@@ -0,0 +1,96 @@
+#include <core/spill_cache.h>
+#include <core/util/range_select.h>
+#include <tuple>
+
+namespace DAQuiri
+{
+
+bool SpillCache::Range::operator<(const Range& other) const
+{
+  return std::tie(idx, min, max) < std::tie(other.idx, other.min, other.max);
+}
+
+bool SpillCache::Range::operator==(const Range& other) const
+{
+  return std::tie(idx, min, max) == std::tie(other.idx, other.min, other.max);
+}
+
+void SpillCache::reset(const Spill* spill)
+{
+  spill_ = spill;
+  masks_.clear();
+  columns_.clear();
+  hits_ = 0;
+}
+
+const uint8_t* SpillCache::mask(const Spill& spill,
+                                const Selection& selection, size_t end)
+{
+  if (&spill != spill_)
+    return nullptr;
+  end = std::min(end, spill.events.size());
+
+  auto& m = masks_[selection];
+  if (m.done >= end)
+  {
+    hits_++;
+    return m.data.data();
+  }
+
+  m.data.resize(spill.events.size(), 1);
+  for (const auto& r : selection)
+  {
+    auto values = fill(spill, r.idx, 0, end);
+    select_within(values + m.done, end - m.done, r.min, r.max, m.data.data() + m.done);
+  }
+  m.done = end;
+  return m.data.data();
+}
+
+const uint32_t* SpillCache::column(const Spill& spill, size_t idx,
+                                   uint16_t downsample, size_t end)
+{
+  if (&spill != spill_)
+    return nullptr;
+  end = std::min(end, spill.events.size());
+
+  auto& c = columns_[{idx, downsample}];
+  if (c.done >= end)
+  {
+    hits_++;
+    return c.data.data();
+  }
+  return fill(spill, idx, downsample, end);
+}
+
+const uint32_t* SpillCache::fill(const Spill& spill, size_t idx,
+                                 uint16_t downsample, size_t end)
+{
+  auto& c = columns_[{idx, downsample}];
+  if (c.done >= end)
+    return c.data.data();
+
+  c.data.resize(spill.events.size(), 0);
+  auto first = spill.events.begin();
+  for (size_t i = c.done; i < end; ++i)
+    c.data[i] = (first + i)->value(idx) >> downsample;
+  c.done = end;
+  return c.data.data();
+}
+
+size_t SpillCache::masks() const
+{
+  return masks_.size();
+}
+
+size_t SpillCache::columns() const
+{
+  return columns_.size();
+}
+
+uint64_t SpillCache::hits() const
+{
+  return hits_;
+}
+
+}
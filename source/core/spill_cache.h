@@ -0,0 +1,65 @@
+#pragma once
+
+#include <core/spill.h>
+#include <map>
+
+namespace DAQuiri
+{
+
+// Per-spill results shared by consumers with identical filters or value
+// latches, so each unique one is evaluated once rather than once per
+// consumer. Filled lazily up to the last event asked for, so chunked
+// spills are evaluated chunk by chunk. Not thread safe, the project
+// uses it under its lock.
+class SpillCache
+{
+ public:
+  //accepted range of one event value
+  struct Range
+  {
+    size_t idx;
+    uint32_t min;
+    uint32_t max;
+
+    bool operator<(const Range& other) const;
+    bool operator==(const Range& other) const;
+  };
+
+  //ranges an event must be within, sorted so equal selections compare equal
+  using Selection = std::vector<Range>;
+
+  //forgets everything, lookups are answered for this spill only
+  void reset(const Spill* spill = nullptr);
+
+  //1 for each of events [0, end) within all ranges, nullptr for other spills
+  const uint8_t* mask(const Spill& spill, const Selection& selection, size_t end);
+
+  //value idx of events [0, end) shifted by downsample, nullptr for other spills
+  const uint32_t* column(const Spill& spill, size_t idx,
+                         uint16_t downsample, size_t end);
+
+  size_t masks() const;
+  size_t columns() const;
+
+  //lookups answered without evaluating any event
+  uint64_t hits() const;
+
+ private:
+  template<typename T>
+  struct Filled
+  {
+    std::vector<T> data;
+    size_t done {0};
+  };
+
+  const Spill* spill_ {nullptr};
+  std::map<Selection, Filled<uint8_t>> masks_;
+  std::map<std::pair<size_t, uint16_t>, Filled<uint32_t>> columns_;
+  uint64_t hits_ {0};
+
+  //extends a column to end, filters read unshifted columns too
+  const uint32_t* fill(const Spill& spill, size_t idx,
+                       uint16_t downsample, size_t end);
+};
+
+}
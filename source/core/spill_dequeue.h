@@ -6,8 +6,11 @@
 #include <map>
 #include <mutex>
 #include <atomic>
+#include <limits>
+#include <algorithm>
 
 #include <core/util/logger.h>
+#include <core/util/latency_histogram.h>
 
 namespace DAQuiri {
 
@@ -58,6 +61,36 @@ private:
   std::condition_variable cond_;
 };
 
+// per-stream timing, all in microseconds
+struct SpillLatency
+{
+    LatencyHistogram enqueue;    // spill creation -> enqueue
+    LatencyHistogram residency;  // enqueue -> dequeue
+    LatencyHistogram processing; // dequeue -> consumers done
+
+    void report(const std::string& stream_id, Setting& stats) const
+    {
+      report(stream_id + "_enqueue", enqueue, stats);
+      report(stream_id + "_residency", residency, stats);
+      report(stream_id + "_processing", processing, stats);
+    }
+
+    static void report(const std::string& prefix,
+                       const LatencyHistogram& h, Setting& stats)
+    {
+      stats.branches.add_a(Setting::integer(prefix + "_p50", h.percentile(50)));
+      stats.branches.add_a(Setting::integer(prefix + "_p99", h.percentile(99)));
+      stats.branches.add_a(Setting::integer(prefix + "_max", h.max()));
+    }
+
+    static uint64_t us(hr_time_t from, hr_time_t to)
+    {
+      if (to <= from)
+        return 0;
+      return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+    }
+};
+
 struct SmartSpillDeque
 {
     // returns true if spill is dropped
@@ -74,17 +107,51 @@ struct SmartSpillDeque
       if (earliest == hr_time_t())
         earliest = s->time;
 
+      auto now = std::chrono::system_clock::now();
+      latency.enqueue.add(SpillLatency::us(s->time, now));
+
+      // spills without a native time sort with the last one that had it
+      double key = last_key;
+      if (event_time(*s, key))
+      {
+        last_key = std::max(last_key, key);
+        started = true;
+      }
+      if (s->type == Spill::Type::start)
+        finished = false;
+      else if (s->type == Spill::Type::stop)
+        finished = true;
+
       queue.push_back(s);
+      enqueued.push_back(now);
+      keys.push_back(key);
 
       return false;
     }
 
+    // native time of a spill, in ns
+    static bool event_time(const Spill& s, double& ns)
+    {
+      Setting t = s.state.find(Setting("native_time"));
+      if (!t)
+        t = s.state.find(Setting("pulse_time"));
+      if (!t)
+        return false;
+      ns = to_double(s.event_model->timebase.to_nanosec(t.get_number()));
+      return true;
+    }
+
     // Must be non-empty
     SpillPtr pop()
     {
       SpillPtr f = queue.front();
       queue.pop_front();
 
+      latency.residency.add(SpillLatency::us(enqueued.front(),
+                                             std::chrono::system_clock::now()));
+      enqueued.pop_front();
+      keys.pop_front();
+
       if (f->type == Spill::Type::running)
         recent_running_spills--;
 
@@ -108,7 +175,15 @@ struct SmartSpillDeque
 
     hr_time_t earliest;
     std::deque<SpillPtr> queue;
+    std::deque<hr_time_t> enqueued;
     size_t recent_running_spills {0};
+
+    // event-time merge
+    std::deque<double> keys;
+    double last_key {-std::numeric_limits<double>::infinity()};
+    bool started {false};
+    bool finished {false};
+    SpillLatency latency;
 };
 
 
@@ -134,7 +209,26 @@ public:
 
     // only do this if enqeued properly
     size_++;
+    if (!data->stream_id.empty() && (first_spill_ == hr_time_t()))
+      first_spill_ = std::chrono::system_clock::now();
     cond_.notify_one();
+    activity_++;
+    control_.notify_all();
+  }
+
+  // order spills by native event time instead of arrival, holding each
+  // one until every running stream has moved past it by max_lateness_ns
+  // of event time, it has waited max_hold on the wall clock, or a stream
+  // buffers max_reorder spills
+  inline void merge_by_event_time(double max_lateness_ns,
+                                  std::chrono::milliseconds max_hold,
+                                  size_t max_reorder)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    by_event_time_ = true;
+    max_lateness_ns_ = std::max(0.0, max_lateness_ns);
+    max_hold_ = std::max(std::chrono::milliseconds(0), max_hold);
+    max_reorder_ = std::max(size_t(1), max_reorder);
   }
 
   // return nullptr if terminating
@@ -142,32 +236,89 @@ public:
   {
     std::unique_lock<std::mutex> lock(mutex_);
 
-    // will not release if empty
-    while (!size_ && !stop_)
-      cond_.wait(lock);
-
-    // this is the end...
-    if (stop_)
-      return nullptr;
-
-    // selecting earliest ensures chronological queue
-    SmartSpillDeque* earliest = &streams_[""];
-    for (auto& s : streams_)
+    while (true)
     {
-      if (!s.second.empty() &&
-          ((earliest->earliest == hr_time_t())
-          || (earliest->earliest > s.second.earliest)))
-        earliest = &s.second;
+      // will not release if empty
+      while (!size_ && !stop_)
+        cond_.wait(lock);
+
+      // this is the end...
+      if (stop_)
+        return nullptr;
+
+      hr_time_t release_at;
+      auto next = release(release_at);
+      if (next)
+        return next;
+      cond_.wait_until(lock, release_at);
     }
+  }
 
-    size_--;
-    return earliest->pop();
+  // does not block, nullptr if nothing can be released yet
+  inline SpillPtr try_dequeue()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!size_ || stop_)
+      return nullptr;
+    hr_time_t release_at;
+    return release(release_at);
   }
 
   inline void stop()
   {
+    std::unique_lock<std::mutex> lock(mutex_);
     stop_ = true;
     cond_.notify_all();
+    control_.notify_all();
+    drained_.notify_all();
+  }
+
+  // wakes wait_activity, e.g. when a producer is done or a run is interrupted
+  inline void notify()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    activity_++;
+    control_.notify_all();
+  }
+
+  // enqueues and notifications so far, to pass to wait_activity
+  inline uint64_t activity()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return activity_;
+  }
+
+  // blocks until there was activity since seen, or for at most timeout,
+  // then brings seen up to date
+  inline void wait_activity(uint64_t& seen, std::chrono::milliseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    control_.wait_for(lock, timeout,
+                      [this, seen] { return (activity_ != seen) || stop_; });
+    seen = activity_;
+  }
+
+  // blocks until every spill enqueued has been dequeued
+  inline void wait_empty()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    control_.wait(lock, [this] { return !size_ || stop_; });
+  }
+
+  // blocks until fewer than limit spills are queued, or for at most
+  // timeout; true if there is room, e.g. for producers that pace themselves
+  inline bool wait_below(size_t limit, std::chrono::milliseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return drained_.wait_for(lock, timeout,
+                             [this, limit] { return (size_ < limit) || stop_; });
+  }
+
+  // when the first spill of a producer stream arrived, unset before that
+  inline hr_time_t first_spill()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return first_spill_;
   }
 
   inline size_t size()
@@ -185,11 +336,48 @@ public:
     return dropped_events_.load();
   }
 
+  // released after a spill with a later native time
+  inline size_t late_spills()
+  {
+    return late_spills_.load();
+  }
+
+  // released before the watermark passed them
+  inline size_t forced_spills()
+  {
+    return forced_spills_.load();
+  }
+
+  // call once a dequeued spill has been handed to all consumers
+  inline void processed(const std::string& stream_id, hr_time_t dequeued)
+  {
+    auto done = std::chrono::system_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    streams_[stream_id].latency.processing.add(SpillLatency::us(dequeued, done));
+  }
+
+  // adds p50, p99 and max in microseconds, per stream and stage
+  inline void latency_stats(Setting& stats)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto& s : streams_)
+      if (!s.first.empty() && s.second.latency.enqueue.count())
+        s.second.latency.report(s.first, stats);
+  }
+
 private:
   std::mutex mutex_;
   std::condition_variable cond_;
   bool stop_ {false};
 
+  // for whoever controls the acquisition, not for consumers of spills
+  std::condition_variable control_;
+  uint64_t activity_ {0};
+
+  // for producers waiting on wait_below
+  std::condition_variable drained_;
+  hr_time_t first_spill_;
+
   std::map<std::string, SmartSpillDeque> streams_;
 
   std::atomic<size_t> size_ {0};
@@ -198,6 +386,82 @@ private:
 
   bool drop_ {false};
   size_t max_buffers_ {10};
+
+  bool by_event_time_ {false};
+  double max_lateness_ns_ {0};
+  hr_time_t::duration max_hold_ {0};
+  size_t max_reorder_ {10};
+  double last_released_ {-std::numeric_limits<double>::infinity()};
+  std::atomic<size_t> late_spills_ {0};
+  std::atomic<size_t> forced_spills_ {0};
+
+  // lock must be held, size_ must be non-zero,
+  // nullptr if held back until release_at
+  SpillPtr release(hr_time_t& release_at)
+  {
+    SmartSpillDeque* next {nullptr};
+    if (by_event_time_)
+      next = next_by_event_time(release_at);
+    else
+    {
+      // selecting earliest ensures chronological queue
+      next = &streams_[""];
+      for (auto& s : streams_)
+      {
+        if (!s.second.empty() &&
+            ((next->earliest == hr_time_t())
+            || (next->earliest > s.second.earliest)))
+          next = &s.second;
+      }
+    }
+    if (!next)
+      return nullptr;
+
+    size_--;
+    if (!size_)
+      control_.notify_all();
+    drained_.notify_all();
+    return next->pop();
+  }
+
+  // lock must be held, size_ must be non-zero
+  SmartSpillDeque* next_by_event_time(hr_time_t& release_at)
+  {
+    double watermark = std::numeric_limits<double>::infinity();
+    SmartSpillDeque* next {nullptr};
+    hr_time_t oldest;
+    bool full {false};
+    for (auto& s : streams_)
+    {
+      auto& q = s.second;
+      if (q.started && !q.finished)
+        watermark = std::min(watermark, q.last_key - max_lateness_ns_);
+      if (q.empty())
+        continue;
+      full |= (q.size() >= max_reorder_);
+      if ((oldest == hr_time_t()) || (q.enqueued.front() < oldest))
+        oldest = q.enqueued.front();
+      if (!next || (q.keys.front() < next->keys.front()))
+        next = &q;
+    }
+
+    release_at = oldest + max_hold_;
+
+    double key = next->keys.front();
+    if (key > watermark)
+    {
+      if (!full && (std::chrono::system_clock::now() < release_at))
+        return nullptr;
+      forced_spills_++;
+    }
+
+    if ((key < last_released_) &&
+        (key != -std::numeric_limits<double>::infinity()))
+      late_spills_++;
+    else
+      last_released_ = key;
+    return next;
+  }
 };
 
 
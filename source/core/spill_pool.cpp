@@ -0,0 +1,105 @@
+#include <core/spill_pool.h>
+
+namespace DAQuiri
+{
+
+SpillPool::Shelf::~Shelf()
+{
+  for (auto s : spills)
+    delete s;
+}
+
+void SpillPool::Shelf::put(Spill* spill)
+{
+  //reset outside the lock, keeping the capacity of raw and events
+  spill->stream_id.clear();
+  spill->type = Spill::Type::daq_status;
+  spill->state = Setting();
+  spill->raw.clear();
+  spill->event_model = SharedEventModel();
+  spill->events.recycle();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (spills.size() < capacity)
+    {
+      spills.push_back(spill);
+      return;
+    }
+  }
+  delete spill;
+}
+
+SpillPtr SpillPool::get(std::string id, Spill::Type type)
+{
+  Spill* spill {nullptr};
+  {
+    std::lock_guard<std::mutex> lock(shelf_->mutex);
+    if (!shelf_->spills.empty())
+    {
+      spill = shelf_->spills.back();
+      shelf_->spills.pop_back();
+    }
+  }
+
+  if (spill)
+  {
+    shelf_->hits++;
+    spill->stream_id = id;
+    spill->type = type;
+    spill->time = std::chrono::system_clock::now();
+    if (type != Spill::Type::daq_status)
+      spill->state = Setting::stem("stats");
+  }
+  else
+  {
+    shelf_->misses++;
+    spill = new Spill(id, type);
+  }
+
+  std::weak_ptr<Shelf> weak_shelf = shelf_;
+  return SpillPtr(spill, [weak_shelf](Spill* s)
+  {
+    if (auto shelf = weak_shelf.lock())
+      shelf->put(s);
+    else
+      delete s;
+  });
+}
+
+uint64_t SpillPool::hits() const
+{
+  return shelf_->hits.load();
+}
+
+uint64_t SpillPool::misses() const
+{
+  return shelf_->misses.load();
+}
+
+size_t SpillPool::available() const
+{
+  std::lock_guard<std::mutex> lock(shelf_->mutex);
+  return shelf_->spills.size();
+}
+
+void SpillPool::set_capacity(size_t capacity)
+{
+  std::lock_guard<std::mutex> lock(shelf_->mutex);
+  shelf_->capacity = capacity;
+  while (shelf_->spills.size() > capacity)
+  {
+    delete shelf_->spills.back();
+    shelf_->spills.pop_back();
+  }
+}
+
+void SpillPool::clear()
+{
+  std::lock_guard<std::mutex> lock(shelf_->mutex);
+  for (auto s : shelf_->spills)
+    delete s;
+  shelf_->spills.clear();
+}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <core/spill.h>
+#include <mutex>
+#include <atomic>
+
+namespace DAQuiri
+{
+
+//Hands out spills whose deleter returns them here once the last holder
+//lets go, so their settings, raw buffer and event storage get reused.
+class SpillPool
+{
+ public:
+  static SpillPool& singleton()
+  {
+    static SpillPool singleton_instance;
+    return singleton_instance;
+  }
+
+  //same as std::make_shared<Spill>(id, type), but recycled if possible
+  SpillPtr get(std::string id, Spill::Type type);
+
+  uint64_t hits() const;
+  uint64_t misses() const;
+  size_t available() const;
+
+  //spills kept for reuse, beyond that they are just deleted
+  void set_capacity(size_t capacity);
+
+  void clear();
+
+ private:
+  struct Shelf
+  {
+    std::mutex mutex;
+    std::vector<Spill*> spills;
+    size_t capacity {64};
+    std::atomic<uint64_t> hits {0};
+    std::atomic<uint64_t> misses {0};
+
+    ~Shelf();
+    void put(Spill* spill);
+  };
+
+  //deleters hold it weakly, so spills outliving the pool still get freed
+  std::shared_ptr<Shelf> shelf_ {std::make_shared<Shelf>()};
+
+  //singleton assurance
+  SpillPool() {}
+  SpillPool(SpillPool const&);
+  void operator=(SpillPool const&);
+};
+
+}
@@ -0,0 +1,70 @@
+#include <core/util/latency_histogram.h>
+#include <algorithm>
+#include <cmath>
+
+static constexpr size_t sub_bits {4};
+static constexpr size_t sub_count {1 << sub_bits};
+static constexpr size_t bucket_count {(64 - sub_bits) * sub_count};
+
+LatencyHistogram::LatencyHistogram()
+  : buckets_(bucket_count, 0)
+{}
+
+size_t LatencyHistogram::index(uint64_t us)
+{
+  if (us < 2 * sub_count)
+    return us;
+  size_t msb = 63;
+  while (!(us >> msb))
+    msb--;
+  size_t shift = msb - sub_bits;
+  return shift * sub_count + (us >> shift);
+}
+
+uint64_t LatencyHistogram::upper_edge(size_t idx)
+{
+  if (idx < 2 * sub_count)
+    return idx;
+  size_t shift = idx / sub_count - 1;
+  uint64_t mantissa = idx % sub_count + sub_count;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::add(uint64_t us)
+{
+  buckets_[index(us)]++;
+  count_++;
+  max_ = std::max(max_, us);
+}
+
+void LatencyHistogram::add(const LatencyHistogram& other)
+{
+  for (size_t i = 0; i < buckets_.size(); ++i)
+    buckets_[i] += other.buckets_[i];
+  count_ += other.count_;
+  max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::clear()
+{
+  std::fill(buckets_.begin(), buckets_.end(), 0);
+  count_ = 0;
+  max_ = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const
+{
+  if (!count_)
+    return 0;
+  p = std::min(std::max(p, 0.0), 100.0);
+  uint64_t target = std::max(uint64_t(1),
+                             uint64_t(std::ceil(p / 100.0 * double(count_))));
+  uint64_t seen {0};
+  for (size_t i = 0; i < buckets_.size(); ++i)
+  {
+    seen += buckets_[i];
+    if (seen >= target)
+      return std::min(upper_edge(i), max_);
+  }
+  return max_;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//Log-linear histogram of durations (in microseconds), in the spirit of
+//HdrHistogram: exact below 32, then 16 sub-buckets per power of two,
+//so any percentile is within ~6% of the true value.
+class LatencyHistogram
+{
+ public:
+  LatencyHistogram();
+
+  void add(uint64_t us);
+  void add(const LatencyHistogram& other);
+  void clear();
+
+  uint64_t count() const { return count_; }
+  uint64_t max() const { return max_; }
+
+  //upper edge of the bucket holding the requested percentile (0-100)
+  uint64_t percentile(double p) const;
+
+ private:
+  std::vector<uint64_t> buckets_;
+  uint64_t count_ {0};
+  uint64_t max_ {0};
+
+  static size_t index(uint64_t us);
+  static uint64_t upper_edge(size_t idx);
+};
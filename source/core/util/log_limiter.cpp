@@ -0,0 +1,50 @@
+#include <core/util/log_limiter.h>
+
+LogLimiter::LogLimiter(uint32_t burst, std::chrono::milliseconds interval)
+  : burst_(burst)
+  , interval_(interval)
+{}
+
+bool LogLimiter::allow(uint64_t& suppressed)
+{
+  total_++;
+
+  auto now = clock::now();
+  if ((now - window_start_) >= interval_)
+  {
+    window_start_ = now;
+    window_count_ = 0;
+  }
+
+  if (window_count_ >= burst_)
+  {
+    pending_++;
+    return false;
+  }
+
+  window_count_++;
+  suppressed = take_suppressed();
+  return true;
+}
+
+uint64_t LogLimiter::take_suppressed()
+{
+  auto ret = pending_;
+  pending_ = 0;
+  return ret;
+}
+
+uint64_t LogLimiter::take_expired()
+{
+  if (!pending_ || ((clock::now() - window_start_) < interval_))
+    return 0;
+  return take_suppressed();
+}
+
+void LogLimiter::reset()
+{
+  window_start_ = clock::time_point();
+  window_count_ = 0;
+  pending_ = 0;
+  total_ = 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <core/util/logger.h>
+#include <chrono>
+
+//Throttles a message logged from a hot path: the first `burst` occurrences
+//in each interval get through, the rest are only counted. The next one to
+//get through is preceded by a count of those held back; if none does, poll
+//take_expired() to report the tail of a flood. Keep one per call site;
+//not thread safe.
+class LogLimiter
+{
+ public:
+  LogLimiter(uint32_t burst = 10,
+             std::chrono::milliseconds interval = std::chrono::seconds(1));
+
+  //counts an occurrence, true if it should be logged, in which case
+  //suppressed is set to the number held back since the last one logged
+  bool allow(uint64_t& suppressed);
+
+  //occurrences counted, logged or not
+  uint64_t total() const { return total_; }
+
+  //held back since the last one logged, cleared when taken
+  uint64_t suppressed() const { return pending_; }
+  uint64_t take_suppressed();
+
+  //like take_suppressed, but only once the interval they fell in is over
+  uint64_t take_expired();
+
+  //forgets all counts, e.g. when a new run starts
+  void reset();
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  uint32_t burst_;
+  clock::duration interval_;
+
+  clock::time_point window_start_;
+  uint32_t window_count_ {0};
+  uint64_t pending_ {0};
+  uint64_t total_ {0};
+};
+
+#define LOG_LIMITED(Limiter, Severity, Format, ...) \
+  do { \
+    uint64_t suppressed_ {0}; \
+    if ((Limiter).allow(suppressed_)) \
+    { \
+      if (suppressed_) \
+        LOG(Severity, "({} similar messages suppressed)", suppressed_); \
+      LOG(Severity, Format, ##__VA_ARGS__); \
+    } \
+  } while (0)
+
+#define ERR_LIMITED(Limiter, Format, ...) LOG_LIMITED(Limiter, spdlog::level::err, Format, ##__VA_ARGS__)
+#define WARN_LIMITED(Limiter, Format, ...) LOG_LIMITED(Limiter, spdlog::level::warn, Format, ##__VA_ARGS__)
+#define INFO_LIMITED(Limiter, Format, ...) LOG_LIMITED(Limiter, spdlog::level::info, Format, ##__VA_ARGS__)
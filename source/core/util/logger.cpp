@@ -1,5 +1,6 @@
 #include <core/util/logger.h>
 
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
@@ -92,8 +93,12 @@ void initLogger(const spdlog::level::level_enum& LoggingLevel,
     sinks.push_back(file_sink);
   }
 
-  auto combined_logger = std::make_shared<spdlog::logger>
-      ("daquiri_logger", begin(sinks), end(sinks));
+  // sinks are written from a background thread; if it falls behind, the
+  // oldest messages are dropped rather than stalling the caller
+  spdlog::init_thread_pool(8192, 1);
+  auto combined_logger = std::make_shared<spdlog::async_logger>
+      ("daquiri_logger", begin(sinks), end(sinks), spdlog::thread_pool(),
+       spdlog::async_overflow_policy::overrun_oldest);
   combined_logger->set_level(LoggingLevel);
   combined_logger->flush_on(LoggingLevel);
   spdlog::flush_every(std::chrono::seconds(1));
@@ -0,0 +1,82 @@
+#include <core/util/range_select.h>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RANGE_SELECT_AVX2
+#include <immintrin.h>
+#endif
+
+//value in [min, max] <=> (value - min) <= (max - min), wrapping unsigned
+void select_within_scalar(const uint32_t* values, size_t count,
+                          uint32_t min, uint32_t max, uint8_t* mask)
+{
+  if (min > max)
+  {
+    std::memset(mask, 0, count);
+    return;
+  }
+  uint32_t span = max - min;
+  for (size_t i = 0; i < count; ++i)
+    mask[i] &= static_cast<uint8_t>((values[i] - min) <= span);
+}
+
+#ifdef RANGE_SELECT_AVX2
+
+//all ones for each of 8 values within span of min
+__attribute__((target("avx2")))
+static inline __m256i within8(const uint32_t* values, __m256i min, __m256i span)
+{
+  auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  auto d = _mm256_sub_epi32(v, min);
+  return _mm256_cmpeq_epi32(_mm256_max_epu32(d, span), span);
+}
+
+//32 values per iteration, returns how many were done
+__attribute__((target("avx2")))
+static size_t select_within_avx2(const uint32_t* values, size_t count,
+                                 uint32_t min, uint32_t span, uint8_t* mask)
+{
+  const auto vmin = _mm256_set1_epi32(static_cast<int32_t>(min));
+  const auto vspan = _mm256_set1_epi32(static_cast<int32_t>(span));
+  const auto one = _mm256_set1_epi8(1);
+  //packing works within 128 bit lanes, this puts bytes back in order
+  const auto order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32)
+  {
+    auto lo = _mm256_packs_epi32(within8(values + i, vmin, vspan),
+                                 within8(values + i + 8, vmin, vspan));
+    auto hi = _mm256_packs_epi32(within8(values + i + 16, vmin, vspan),
+                                 within8(values + i + 24, vmin, vspan));
+    auto bytes = _mm256_permutevar8x32_epi32(_mm256_packs_epi16(lo, hi), order);
+
+    auto m = reinterpret_cast<__m256i*>(mask + i);
+    _mm256_storeu_si256(m, _mm256_and_si256(_mm256_loadu_si256(m),
+                                            _mm256_and_si256(bytes, one)));
+  }
+  return i;
+}
+
+#endif
+
+bool select_within_vectorized()
+{
+#ifdef RANGE_SELECT_AVX2
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2;
+#else
+  return false;
+#endif
+}
+
+void select_within(const uint32_t* values, size_t count,
+                   uint32_t min, uint32_t max, uint8_t* mask)
+{
+  size_t done {0};
+#ifdef RANGE_SELECT_AVX2
+  if ((min <= max) && select_within_vectorized())
+    done = select_within_avx2(values, count, min, max - min, mask);
+#endif
+  select_within_scalar(values + done, count - done, min, max, mask + done);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+//Batch range selection over a column of event values. Clears mask[i]
+//(one byte per event, 0 or 1) for every value outside [min, max] and
+//leaves the rest alone, so several ranges can be ANDed into one mask.
+//Uses AVX2 when the CPU has it, chosen at run time.
+void select_within(const uint32_t* values, size_t count,
+                   uint32_t min, uint32_t max, uint8_t* mask);
+
+//same, one value at a time
+void select_within_scalar(const uint32_t* values, size_t count,
+                          uint32_t min, uint32_t max, uint8_t* mask);
+
+//whether select_within runs vectorized on this machine
+bool select_within_vectorized();
@@ -21,6 +21,7 @@ void ThreadRunner::terminate()
 {
   if (interruptor_)
     interruptor_->store(true);
+  engine_.wake();
   terminating_.store(true);
   wait();
 }
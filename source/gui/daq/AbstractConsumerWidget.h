@@ -18,9 +18,24 @@ public:
   inline void setConsumer(DAQuiri::ConsumerPtr consumer)
   {
     consumer_ = consumer;
+    if (consumer_)
+      generation_ = consumer_->generation();
     update();
   }
 
+  //re-fetches data only if visible and consumer changed since last time
+  inline bool update_if_changed()
+  {
+    if (!consumer_ || !isVisible())
+      return false;
+    auto generation = consumer_->generation();
+    if (generation == generation_)
+      return false;
+    generation_ = generation;
+    update();
+    return true;
+  }
+
   inline DAQuiri::ConsumerPtr consumer() const
   {
     return consumer_;
@@ -31,4 +46,5 @@ public:
 
 protected:
   DAQuiri::ConsumerPtr consumer_;
+  uint64_t generation_ {0};
 };
@@ -70,9 +70,24 @@ void Consumer2D::update()
     rescale = 1;
 
   QPlot::HistList2D hist;
+  DataAxis axis_x, axis_y;
   if (data)
   {
-    auto spectrum_data = data->all_data();
+    axis_x = data->axis(0);
+    axis_y = data->axis(1);
+  }
+
+  if (!axis_x.domain.empty() && !axis_y.domain.empty())
+  {
+    //no point fetching more tiles than there are pixels to show them
+    std::vector<Pair> ranges {axis_x.bounds(), axis_y.bounds()};
+    Coords resolution {static_cast<size_t>(std::max(plot_->width(), 1)),
+                       static_cast<size_t>(std::max(plot_->height(), 1))};
+    auto factors = Dataspace::binning_factors(ranges, resolution);
+    factor_x_ = factors[0];
+    factor_y_ = factors[1];
+
+    auto spectrum_data = data->range_binned(ranges, resolution);
     if (spectrum_data)
       for (const auto& p : *spectrum_data)
         hist.push_back(QPlot::p2d(p.first[0],
@@ -82,55 +97,63 @@ void Consumer2D::update()
 
   if (!hist.empty())
   {
-    DataAxis axis_x = data->axis(0);
-    DataAxis axis_y = data->axis(1);
+    x_domain.clear();
+    for (size_t i = 0; i < axis_x.domain.size(); i += factor_x_)
+      x_domain.push_back(axis_x.domain[i]);
+    y_domain.clear();
+    for (size_t i = 0; i < axis_y.domain.size(); i += factor_y_)
+      y_domain.push_back(axis_y.domain[i]);
 
-    x_domain = axis_x.domain;
-    y_domain = axis_y.domain;
-
-    uint32_t res_x = axis_x.bounds().second;
-    uint32_t res_y = axis_y.bounds().second;
+    uint32_t res_x = x_domain.size() - 1;
+    uint32_t res_y = y_domain.size() - 1;
 
     plot_->clearExtras();
     plot_->clearData();
     plot_->setAxes(
-        QS(axis_x.label()), x_domain[0], x_domain[res_x],
-        QS(axis_y.label()), y_domain[0], y_domain[res_y],
+        QS(axis_x.label()), x_domain[0], axis_x.domain.back(),
+        QS(axis_y.label()), y_domain[0], axis_y.domain.back(),
         "count");
 
-    if (box_visible)
+    size_t tile_x = box_x / factor_x_;
+    size_t tile_y = box_y / factor_y_;
+    if (box_visible && (tile_x < x_domain.size()) && (tile_y < y_domain.size()))
     {
       QPlot::MarkerBox2D box;
 
       box.border = Qt::black;
       box.fill = QColor(0, 0, 0, 32);
 
-      box.x1 = box.x2 = x_domain[box_x];
-      if (box_x > 0)
+      box.x1 = box.x2 = x_domain[tile_x];
+      if (tile_x > 0)
       {
-        box.x1 += x_domain[box_x - 1];
+        box.x1 += x_domain[tile_x - 1];
         box.x1 /= 2;
       }
-      if ((box_x + 1u) < x_domain.size())
+      if ((tile_x + 1u) < x_domain.size())
       {
-        box.x2 += x_domain[box_x + 1];
+        box.x2 += x_domain[tile_x + 1];
         box.x2 /= 2;
       }
 
-      box.y1 = box.y2 = y_domain[box_y];
-      if (box_y > 0)
+      box.y1 = box.y2 = y_domain[tile_y];
+      if (tile_y > 0)
       {
-        box.y1 += y_domain[box_y - 1];
+        box.y1 += y_domain[tile_y - 1];
         box.y1 /= 2;
       }
-      if ((box_y + 1u) < y_domain.size())
+      if ((tile_y + 1u) < y_domain.size())
       {
-        box.y2 += y_domain[box_y + 1];
+        box.y2 += y_domain[tile_y + 1];
         box.y2 /= 2;
       }
 
       QPlot::Label2D label;
-      label.text = QString::number(double(data->get({box_x, box_y})));
+      size_t bx = tile_x * factor_x_;
+      size_t by = tile_y * factor_y_;
+      auto tile = data->range_binned({{bx, bx + factor_x_ - 1},
+                                      {by, by + factor_y_ - 1}}, {1, 1});
+      double count = (tile && !tile->empty()) ? to_double(tile->front().second) : 0;
+      label.text = QString::number(count);
       label.x = box.x2;
       label.y = plot_->flipY() ? box.y2 : box.y1;
 
@@ -216,8 +239,11 @@ void Consumer2D::clickedPlot(double x, double y, Qt::MouseButton button)
   box_visible = (button == Qt::MouseButton::LeftButton) &&
       (x >= 0) && (x < x_domain.size()) &&  (y >= 0) && (y < y_domain.size());
 
-  box_x = static_cast<uint16_t>(x);
-  box_y = static_cast<uint16_t>(y);
+  if (box_visible)
+  {
+    box_x = static_cast<size_t>(x) * factor_x_;
+    box_y = static_cast<size_t>(y) * factor_y_;
+  }
 
   update();
 }
@@ -27,9 +27,13 @@ class Consumer2D : public AbstractConsumerWidget
   bool initial_scale_{false};
   bool user_zoomed_{false};
 
-  uint16_t box_x, box_y;
+  //selected bin, not tile, so it survives changes of the tiling
+  size_t box_x {0}, box_y {0};
   bool box_visible {false};
 
+  //domains sampled at tile starts, plot coordinates are tile indices
   std::vector<double> x_domain;
   std::vector<double> y_domain;
+  size_t factor_x_ {1};
+  size_t factor_y_ {1};
 };
@@ -220,6 +220,7 @@ void ListModeForm::on_pushListStop_clicked()
   ui->pushListStop->setEnabled(false);
   INFO("List acquisition interrupted by user");
   interruptor_.store(true);
+  Engine::singleton().wake();
 }
 
 void ListModeForm::list_completed(ListData newEvents)
@@ -282,7 +283,7 @@ void ListModeForm::spill_selection_changed(QItemSelection, QItemSelection)
 
       ui->treeAttribs->setVisible(sp->state != Setting());
       ui->labelState->setVisible(sp->state != Setting());
-      event_model_ = sp->event_model;
+      event_model_ = *sp->event_model;
 
 //      DBG( "Received event model " << event_model_;
 
@@ -341,7 +342,7 @@ void ListModeForm::trace_selection_changed(QItemSelection, QItemSelection)
 
     SpillPtr sp3 = std::make_shared<Spill>(sp->stream_id, Spill::Type::running);
     sp3->event_model = sp->event_model;
-    sp3->events.reserve(1, sp->event_model);
+    sp3->events.reserve(1, *sp->event_model);
     sp3->events.last() = events_[event_i];
     ++sp3->events;
     sp3->events.finalize();
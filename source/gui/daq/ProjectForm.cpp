@@ -251,7 +251,7 @@ void ProjectForm::update_plots()
   }
 
   if (ui->projectView->isVisible())
-    ui->projectView->update_plots();
+    plot_thread_.report_render_time(ui->projectView->update_plots());
 }
 
 void ProjectForm::projectOpen()
@@ -460,6 +460,7 @@ void ProjectForm::on_pushStop_clicked()
 {
   ui->pushStop->setEnabled(false);
   interruptor_.store(true);
+  Engine::singleton().wake();
 }
 
 void ProjectForm::run_completed()
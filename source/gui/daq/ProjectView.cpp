@@ -235,17 +235,20 @@ void ProjectView::enforce_all()
     enforce_tile_policy();
 }
 
-void ProjectView::update_plots()
+double ProjectView::update_plots()
 {
-//  Timer t(true);
-  for (auto& consumer_widget : consumers_)
-    consumer_widget->update();
+  Timer t(true);
 
+  QList<AbstractConsumerWidget*> updated;
   for (auto& consumer_widget : consumers_)
+    if (consumer_widget->update_if_changed())
+      updated.push_back(consumer_widget);
+
+  for (auto& consumer_widget : updated)
     consumer_widget->refresh();
 
   selectorItemSelected(SelectorItem());
-//  DBG( "<ProjectView> plotting took " << t.s();
+  return t.ms();
 }
 
 void ProjectView::on_pushFullInfo_clicked()
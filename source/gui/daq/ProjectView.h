@@ -27,7 +27,8 @@ class ProjectView : public QWidget
 
     void updateUI();
 
-    void update_plots();
+    //returns time spent rendering, in ms
+    double update_plots();
 
 //  protected:
 //    void closeEvent(QCloseEvent*);
@@ -4,6 +4,8 @@
 #include <QMutex>
 #include <core/project.h>
 #include <core/util/logger.h>
+#include <algorithm>
+#include <atomic>
 
 class ThreadPlotSignal : public QThread
 {
@@ -36,6 +38,23 @@ public:
     wait_ms_.store(time);
   }
 
+  //called from GUI thread after each refresh, smoothed over a few refreshes
+  void report_render_time(double ms)
+  {
+    render_ms_.store(0.7 * render_ms_.load() + 0.3 * ms);
+  }
+
+  //at least the user-set pause, but longer if rendering is expensive,
+  //so that plotting does not keep consumers locked away from acquisition
+  uint32_t wait_time() const
+  {
+    double adaptive = render_ms_.load() * render_cost_factor;
+    if (adaptive > max_adaptive_wait_ms)
+      adaptive = max_adaptive_wait_ms;
+    return std::max(static_cast<uint32_t>(wait_ms_.load()),
+                    static_cast<uint32_t>(adaptive));
+  }
+
   DAQuiri::ProjectPtr current_source()
   {
     QMutexLocker locker(&mutex_);
@@ -58,7 +77,7 @@ protected:
       emit plot_ready();
 //      DBG( "<ThreadPlotSignal> Plot ready";
       if (!terminating_.load())
-        QThread::msleep(wait_ms_.load());
+        QThread::msleep(wait_time());
     }
 //    DBG( "<ThreadPlot> loop ended";
   }
@@ -68,6 +87,11 @@ private:
   DAQuiri::ProjectPtr project_;
   std::atomic<bool> terminating_;
   std::atomic<uint16_t> wait_ms_;
+  std::atomic<double> render_ms_ {0};
+
+  //rendering should take no more than 1/render_cost_factor of the time
+  static constexpr double render_cost_factor {5};
+  static constexpr double max_adaptive_wait_ms {10000};
 
   void terminate_helper()
   {
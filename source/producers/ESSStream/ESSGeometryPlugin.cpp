@@ -1,5 +1,7 @@
 #include <producers/ESSStream/ESSGeometryPlugin.h>
 
+constexpr uint16_t ESSGeometryPlugin::invalid_;
+
 ESSGeometryPlugin::ESSGeometryPlugin()
 {
   std::string r{plugin_name()};
@@ -20,12 +22,19 @@ ESSGeometryPlugin::ESSGeometryPlugin()
   ep.set_val("min", 1);
   add_definition(ep);
 
+  SettingMeta ll(r + "/lookup_limit", SettingType::integer, "Largest id space decoded by table");
+  ll.set_val("min", 0);
+  ll.set_val("max", 1 << 28);
+  ll.set_val("description", "Pixel ids are decoded arithmetically above this");
+  add_definition(ll);
+
   int32_t i{0};
   SettingMeta root(r, SettingType::stem, "Logical geometry");
   root.set_enum(i++, r + "/extent_x");
   root.set_enum(i++, r + "/extent_y");
   root.set_enum(i++, r + "/extent_z");
   root.set_enum(i++, r + "/panels");
+  root.set_enum(i++, r + "/lookup_limit");
   add_definition(root);
 }
 
@@ -37,6 +46,7 @@ Setting ESSGeometryPlugin::settings() const
   set.set(Setting::integer(r + "/extent_y", integer_t(geometry_.ny())));
   set.set(Setting::integer(r + "/extent_z", integer_t(geometry_.nz())));
   set.set(Setting::integer(r + "/panels", integer_t(geometry_.np())));
+  set.set(Setting::integer(r + "/lookup_limit", integer_t(lookup_limit_)));
   return set;
 }
 
@@ -47,6 +57,37 @@ void ESSGeometryPlugin::settings(const Setting& settings)
   geometry_.ny(settings.find({r + "/extent_y"}).get_number());
   geometry_.nz(settings.find({r + "/extent_z"}).get_number());
   geometry_.np(settings.find({r + "/panels"}).get_number());
+  auto limit = settings.find({r + "/lookup_limit"});
+  if (limit)
+    lookup_limit_ = static_cast<uint32_t>(std::max(integer_t(0), limit.get_int()));
+  build_lookup();
+}
+
+void ESSGeometryPlugin::build_lookup()
+{
+  lookup_.clear();
+
+  uint64_t nx = geometry_.nx();
+  uint64_t ny = geometry_.ny();
+  uint64_t nz = geometry_.nz();
+  uint64_t np = geometry_.np();
+  if ((nx >= invalid_) || (ny >= invalid_) || (nz >= invalid_) || (np >= invalid_))
+    return;
+  //ids are 1-based, the table is indexed by id directly
+  uint64_t ids = nx * ny * nz * np + 1;
+  if (ids > lookup_limit_)
+    return;
+
+  lookup_.resize(ids, Pixel{invalid_, invalid_, invalid_, invalid_});
+  for (uint32_t id = 0; id < ids; ++id)
+  {
+    if (!geometry_.valid_id(id))
+      continue;
+    lookup_[id] = Pixel{static_cast<uint16_t>(geometry_.x(id)),
+                        static_cast<uint16_t>(geometry_.y(id)),
+                        static_cast<uint16_t>(geometry_.z(id)),
+                        static_cast<uint16_t>(geometry_.p(id))};
+  }
 }
 
 void ESSGeometryPlugin::define(EventModel& definition)
@@ -57,13 +98,7 @@ void ESSGeometryPlugin::define(EventModel& definition)
   definition.add_value("panel", geometry_.np());
 }
 
-bool ESSGeometryPlugin::fill(Event& event, uint32_t pixel_id)
+bool ESSGeometryPlugin::fill(Event& event, uint32_t pixel_id) const
 {
-  if (!geometry_.valid_id(pixel_id)) //must be non0?
-    return false;
-  event.set_value(0, geometry_.x(pixel_id));
-  event.set_value(1, geometry_.y(pixel_id));
-  event.set_value(2, geometry_.z(pixel_id));
-  event.set_value(3, geometry_.p(pixel_id));
-  return true;
+  return set_values(event, pixel_id);
 }
\ No newline at end of file
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <core/plugin/plugin.h>
-#include <core/event.h>
+#include <core/spill.h>
 #include <logical_geometry/ESSGeometry.h>
+#include <limits>
 
 using namespace DAQuiri;
 
@@ -16,8 +17,76 @@ class ESSGeometryPlugin : public Plugin
     void settings(const Setting&) override;
 
     void define(EventModel& definition);
-    bool fill(Event& event, uint32_t pixel_id);
+    bool fill(Event& event, uint32_t pixel_id) const;
+
+    //appends an event for each valid id in pixel_ids[0, count), at times[i],
+    //to a buffer reserved by the caller; rejected(id) is called for the rest
+    template<typename Rejected>
+    size_t fill(EventBuffer& events, const uint64_t* times,
+                const uint32_t* pixel_ids, size_t count, Rejected rejected) const;
+
+    //whether ids are decoded from a lookup table rather than arithmetic
+    bool has_lookup() const { return !lookup_.empty(); }
 
   private:
     ESSGeometry geometry_{1, 1, 1, 1};
+
+    //id spaces up to this size are decoded through lookup_
+    uint32_t lookup_limit_ {1 << 22};
+
+    struct Pixel
+    {
+      uint16_t x, y, z, p;
+    };
+    static constexpr uint16_t invalid_ {std::numeric_limits<uint16_t>::max()};
+
+    //coordinates of every id up to the largest valid one, invalid ids
+    //have x == invalid_
+    std::vector<Pixel> lookup_;
+
+    void build_lookup();
+
+    inline bool set_values(Event& event, uint32_t pixel_id) const
+    {
+      if (pixel_id < lookup_.size())
+      {
+        const auto& px = lookup_[pixel_id];
+        if (px.x == invalid_)
+          return false;
+        event.set_value(0, px.x);
+        event.set_value(1, px.y);
+        event.set_value(2, px.z);
+        event.set_value(3, px.p);
+        return true;
+      }
+      //table covers all valid ids
+      if (!lookup_.empty() || !geometry_.valid_id(pixel_id))
+        return false;
+      event.set_value(0, geometry_.x(pixel_id));
+      event.set_value(1, geometry_.y(pixel_id));
+      event.set_value(2, geometry_.z(pixel_id));
+      event.set_value(3, geometry_.p(pixel_id));
+      return true;
+    }
 };
+
+template<typename Rejected>
+size_t ESSGeometryPlugin::fill(EventBuffer& events, const uint64_t* times,
+                               const uint32_t* pixel_ids, size_t count,
+                               Rejected rejected) const
+{
+  size_t filled {0};
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto& evt = events.last();
+    if (set_values(evt, pixel_ids[i]))
+    {
+      evt.set_time(times[i]);
+      ++events;
+      filled++;
+    }
+    else
+      rejected(pixel_ids[i]);
+  }
+  return filled;
+}
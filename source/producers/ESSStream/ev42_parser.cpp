@@ -2,6 +2,7 @@
 #include "ev42_events_generated.h"
 
 #include <core/util/timer.h>
+#include <core/spill_pool.h>
 #include <core/util/logger.h>
 
 ev42_events::ev42_events()
@@ -61,7 +62,7 @@ Setting ev42_events::settings() const
   set.set(Setting::integer(r + "/MessageOrdering", ordering_));
 
   set.branches.add_a(geometry_.settings());
-  set.branches.add_a(TimeBasePlugin(event_definition_.timebase).settings());
+  set.branches.add_a(TimeBasePlugin(event_definition_->timebase).settings());
 
   set.enable_if_flag(!(status_ & booted), "preset");
   return set;
@@ -84,18 +85,19 @@ void ev42_events::settings(const Setting& settings)
   TimeBasePlugin tbs;
   tbs.settings(set.find({tbs.plugin_name()}));
   event_definition_ = EventModel();
-  event_definition_.timebase = tbs.timebase();
+  event_definition_.edit().timebase = tbs.timebase();
   geometry_.settings(set.find({geometry_.plugin_name()}));
-  geometry_.define(event_definition_);
+  geometry_.define(event_definition_.edit());
 }
 
 StreamManifest ev42_events::stream_manifest() const
 {
   StreamManifest ret;
-  ret[stream_id_].event_model = event_definition_;
+  ret[stream_id_].event_model = *event_definition_;
   ret[stream_id_].stats.branches.add(SettingMeta("native_time", SettingType::precise));
   ret[stream_id_].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
   ret[stream_id_].stats.branches.add(SettingMeta("pulse_time", SettingType::precise));
+  ret[stream_id_].stats.branches.add(SettingMeta("bad_pixels", SettingType::precise));
   return ret;
 }
 
@@ -106,8 +108,11 @@ uint64_t ev42_events::stop(SpillQueue spill_queue)
     auto ret = std::make_shared<Spill>(stream_id_, Spill::Type::stop);
     ret->state.branches.add(Setting::precise("native_time", stats.time_end));
     ret->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
+    ret->state.branches.add(Setting::precise("bad_pixels", bad_pixel_log_.total()));
     spill_queue->enqueue(ret);
     started_ = false;
+    if (auto n = bad_pixel_log_.take_suppressed())
+      WARN("<ev42_events> {} more out of range Pixids not logged", n);
     return 1;
   }
   return 0;
@@ -145,9 +150,18 @@ uint64_t ev42_events::process_payload(SpillQueue spill_queue, void* msg)
     return 0;
   }
 
+  //bad pixel count is published per run
+  if (!started_)
+    bad_pixel_log_.reset();
+  else if (auto n = bad_pixel_log_.take_expired())
+    WARN("<ev42_events> {} more out of range Pixids not logged", n);
+  if (auto n = ordering_log_.take_expired())
+    WARN("<ev42_events> {} more out of order buffers not logged", n);
+
   if ((ordering_ != Ignore) && !in_order(em))
   {
-    WARN("Buffer out of order ({}<={}) {}", em->message_id(), latest_buf_id_, debug(em));
+    WARN_LIMITED(ordering_log_, "Buffer out of order ({}<={}) {}",
+                 em->message_id(), latest_buf_id_, debug(em));
     if (ordering_ == Reject)
     {
       stats.time_spent += timer.s();
@@ -164,35 +178,34 @@ uint64_t ev42_events::process_payload(SpillQueue spill_queue, void* msg)
 
   stats.time_start = stats.time_end = time_high;
 
-  SpillPtr run_spill = std::make_shared<Spill>(stream_id_, Spill::Type::running);
+  SpillPtr run_spill = SpillPool::singleton().get(stream_id_, Spill::Type::running);
   run_spill->event_model = event_definition_;
-  run_spill->events.reserve(event_count, event_definition_);
+  run_spill->events.reserve(event_count, *event_definition_);
 
+  times_.resize(event_count);
+  auto tof = em->time_of_flight();
   for (size_t i=0; i < event_count; ++i)
   {
-    uint64_t time = em->time_of_flight()->Get(i);
+    uint64_t time = tof->Get(i);
     time += time_high;
     if (i==0)
       stats.time_start = time;
     stats.time_start = std::min(stats.time_start, time);
     stats.time_end = std::max(stats.time_end, time);
-
-    auto& evt = run_spill->events.last();
-    if (geometry_.fill(evt, em->detector_id()->Get(i)))
-    {
-      evt.set_time(time);
-      ++ run_spill->events;
-    }
-    else
-    {
-      WARN("Out of range Pixid={}", em->detector_id()->Get(i));
-    }
-//    DBG( "Time " << stats.time_start << " - " << stats.time_end;
+    times_[i] = time;
   }
+
+  geometry_.fill(run_spill->events, times_.data(),
+                 em->detector_id()->data(), event_count,
+                 [this](uint32_t pixel_id)
+                 {
+                   WARN_LIMITED(bad_pixel_log_, "Out of range Pixid={}", pixel_id);
+                 });
   run_spill->events.finalize();
 
   run_spill->state.branches.add(Setting::precise("native_time", stats.time_end));
   run_spill->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
+  run_spill->state.branches.add(Setting::precise("bad_pixels", bad_pixel_log_.total()));
 
   if (spoof_clock_ == Monotonous)
     run_spill->state.branches.add(Setting::precise("pulse_time", time_high));
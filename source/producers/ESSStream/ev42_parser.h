@@ -2,6 +2,7 @@
 
 #include <producers/ESSStream/fb_parser.h>
 #include <producers/ESSStream/ESSGeometryPlugin.h>
+#include <core/util/log_limiter.h>
 
 using namespace DAQuiri;
 
@@ -47,7 +48,7 @@ class ev42_events : public fb_parser
 
   std::string stream_id_;
   ESSGeometryPlugin geometry_;
-  EventModel event_definition_;
+  SharedEventModel event_definition_;
   Spoof spoof_clock_{None};
   bool heartbeat_{false};
 
@@ -62,6 +63,13 @@ class ev42_events : public fb_parser
   // stream error checking
   uint64_t latest_buf_id_{0};
 
+  // per-event warnings, totals are reported as stream stats
+  LogLimiter bad_pixel_log_;
+  LogLimiter ordering_log_;
+
+  // event times of the buffer being decoded
+  std::vector<uint64_t> times_;
+
   bool in_order(const EventMessage*);
   size_t events_in_buffer(const EventMessage*);
   std::string debug(const EventMessage*);
@@ -1,6 +1,7 @@
 #include <producers/ESSStream/f142_parser.h>
 
 #include <core/util/timer.h>
+#include <core/spill_pool.h>
 #include <core/util/logger.h>
 
 ChopperTDC::ChopperTDC()
@@ -35,7 +36,7 @@ ChopperTDC::ChopperTDC()
 StreamManifest ChopperTDC::stream_manifest() const
 {
   StreamManifest ret;
-  ret[stream_id_].event_model = event_model_;
+  ret[stream_id_].event_model = *event_model_;
   ret[stream_id_].stats.branches.add(SettingMeta("native_time", SettingType::precise));
   ret[stream_id_].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
   return ret;
@@ -50,7 +51,7 @@ Setting ChopperTDC::settings() const
   set.set(Setting::boolean(r + "/FilterSourceName", filter_source_name_));
   set.set(Setting::text(r + "/SourceName", source_name_));
 
-  set.branches.add_a(TimeBasePlugin(event_model_.timebase).settings());
+  set.branches.add_a(TimeBasePlugin(event_model_->timebase).settings());
 
   set.enable_if_flag(!(status_ & booted), "preset");
   return set;
@@ -66,7 +67,7 @@ void ChopperTDC::settings(const Setting& settings)
 
   TimeBasePlugin tbs;
   tbs.settings(set.find({tbs.plugin_name()}));
-  event_model_.timebase = tbs.timebase();
+  event_model_.edit().timebase = tbs.timebase();
 }
 
 uint64_t ChopperTDC::stop(SpillQueue spill_queue)
@@ -120,11 +121,11 @@ uint64_t ChopperTDC::process_payload(SpillQueue spill_queue, void* msg)
 
   stats.time_start = stats.time_end = ChopperTDCTimeStamp->timestamp();
 
-  auto ret = std::make_shared<Spill>(stream_id_, Spill::Type::running);
+  auto ret = SpillPool::singleton().get(stream_id_, Spill::Type::running);
   ret->state.branches.add(Setting::precise("native_time", ChopperTDCTimeStamp->timestamp()));
   ret->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
   ret->event_model = event_model_;
-  ret->events.reserve(1, event_model_);
+  ret->events.reserve(1, *event_model_);
 
   auto& e = ret->events.last();
   e.set_time(ChopperTDCTimeStamp->timestamp());
@@ -35,7 +35,7 @@ class ChopperTDC : public fb_parser
   bool filter_source_name_{false};
   std::string source_name_;
 
-  EventModel event_model_;
+  SharedEventModel event_model_;
 
   bool started_{false};
 
@@ -1,6 +1,7 @@
 #include <producers/ESSStream/mo01_parser.h>
 
 #include <core/util/timer.h>
+#include <core/spill_pool.h>
 #include <core/util/logger.h>
 
 mo01_nmx::mo01_nmx()
@@ -43,19 +44,19 @@ mo01_nmx::mo01_nmx()
   root.set_enum(i++, r + "/SourceName");
   add_definition(root);
 
-  hists_model_.add_trace("strips_x", {UINT16_MAX+1});
-  hists_model_.add_trace("strips_y", {UINT16_MAX+1});
-  hists_model_.add_trace("adc_x", {UINT16_MAX+1});
-  hists_model_.add_trace("adc_y", {UINT16_MAX+1});
-  hists_model_.add_trace("adc_cluster", {UINT16_MAX+1});
+  hists_model_.edit().add_trace("strips_x", {UINT16_MAX+1});
+  hists_model_.edit().add_trace("strips_y", {UINT16_MAX+1});
+  hists_model_.edit().add_trace("adc_x", {UINT16_MAX+1});
+  hists_model_.edit().add_trace("adc_y", {UINT16_MAX+1});
+  hists_model_.edit().add_trace("adc_cluster", {UINT16_MAX+1});
 
-  track_model_.add_value("strip", 0);
-  track_model_.add_value("time", 0);
-  track_model_.add_value("adc", 0);
+  track_model_.edit().add_value("strip", 0);
+  track_model_.edit().add_value("time", 0);
+  track_model_.edit().add_value("adc", 0);
 
-  hits_model_.add_value("plane", 0);
-  hits_model_.add_value("channel", 0);
-  hits_model_.add_value("adc", 0);
+  hits_model_.edit().add_value("plane", 0);
+  hits_model_.edit().add_value("channel", 0);
+  hits_model_.edit().add_value("adc", 0);
 
   status_ = ProducerStatus::loaded | ProducerStatus::can_boot;
 }
@@ -72,7 +73,7 @@ Setting mo01_nmx::settings() const
   set.set(Setting::boolean(r + "/FilterSourceName", filter_source_name_));
   set.set(Setting::text(r + "/SourceName", source_name_));
 
-  set.branches.add_a(TimeBasePlugin(hists_model_.timebase).settings());
+  set.branches.add_a(TimeBasePlugin(hists_model_->timebase).settings());
 
   set.enable_if_flag(!(status_ & booted), "preset");
   return set;
@@ -92,25 +93,25 @@ void mo01_nmx::settings(const Setting& settings)
 
   TimeBasePlugin tbs;
   tbs.settings(set.find({tbs.plugin_name()}));
-  hists_model_.timebase = tbs.timebase();
+  hists_model_.edit().timebase = tbs.timebase();
 }
 
 StreamManifest mo01_nmx::stream_manifest() const
 {
   StreamManifest ret;
-  ret[hists_stream_id_].event_model = hists_model_;
+  ret[hists_stream_id_].event_model = *hists_model_;
   ret[hists_stream_id_].stats.branches.add(SettingMeta("native_time", SettingType::precise));
   ret[hists_stream_id_].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
 
-  ret[x_stream_id_].event_model = track_model_;
+  ret[x_stream_id_].event_model = *track_model_;
   ret[x_stream_id_].stats.branches.add(SettingMeta("native_time", SettingType::precise));
   ret[x_stream_id_].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
 
-  ret[y_stream_id_].event_model = track_model_;
+  ret[y_stream_id_].event_model = *track_model_;
   ret[y_stream_id_].stats.branches.add(SettingMeta("native_time", SettingType::precise));
   ret[y_stream_id_].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
 
-  ret[hit_stream_id_].event_model = hits_model_;
+  ret[hit_stream_id_].event_model = *hits_model_;
   ret[hit_stream_id_].stats.branches.add(SettingMeta("native_time", SettingType::precise));
   ret[hit_stream_id_].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
   return ret;
@@ -227,11 +228,11 @@ uint64_t mo01_nmx::produce_hists(const GEMHist& hist, SpillQueue queue)
       !hist.cluster_spectrum()->Length())
     return 0;
 
-  auto ret = std::make_shared<Spill>(hists_stream_id_, Spill::Type::running);
+  auto ret = SpillPool::singleton().get(hists_stream_id_, Spill::Type::running);
   ret->state.branches.add(Setting::precise("native_time", spoofed_time_));
   ret->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
   ret->event_model = hists_model_;
-  ret->events.reserve(1, hists_model_);
+  ret->events.reserve(1, *hists_model_);
 
 //  DBG( "Received GEMHist\n" << debug(hist);
 
@@ -274,11 +275,11 @@ uint64_t mo01_nmx::produce_tracks(const GEMTrack& track, SpillQueue queue)
 
 uint64_t mo01_nmx::produce_hits(const MONHit& hits, SpillQueue queue)
 {
-  auto spill = std::make_shared<Spill>(hit_stream_id_, Spill::Type::running);
+  auto spill = SpillPool::singleton().get(hit_stream_id_, Spill::Type::running);
   spill->state.branches.add(Setting::precise("native_time", spoofed_time_));
   spill->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
   spill->event_model = hits_model_;
-  spill->events.reserve(hits.plane()->Length(), hits_model_);
+  spill->events.reserve(hits.plane()->Length(), *hits_model_);
 
   for (size_t i=0; i < hits.plane()->Length(); ++i)
   {
@@ -307,6 +308,7 @@ void mo01_nmx::grab_hist(Event& e, size_t idx, const flatbuffers::Vector<uint32_
     return;
 //  std::vector<uint32_t> vals(data->Length(), 0);
   auto& trace = e.trace(idx);
+  trace.resize(data->Length());
   for (size_t i=0; i < data->Length(); ++i)
     trace[i] = data->Get(i);
 //  DBG( "Added hist " << idx << " length " << data->Length();
@@ -315,12 +317,12 @@ void mo01_nmx::grab_hist(Event& e, size_t idx, const flatbuffers::Vector<uint32_
 SpillPtr mo01_nmx::grab_track(const flatbuffers::Vector<flatbuffers::Offset<pos>>* data,
                               std::string stream)
 {
-  auto ret = std::make_shared<Spill>(stream, Spill::Type::running);
+  auto ret = SpillPool::singleton().get(stream, Spill::Type::running);
 
   ret->state.branches.add(Setting::precise("native_time", spoofed_time_));
   ret->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
   ret->event_model = track_model_;
-  ret->events.reserve(data->Length(), track_model_);
+  ret->events.reserve(data->Length(), *track_model_);
 
   for (size_t i=0; i < data->Length(); ++i)
   {
@@ -37,9 +37,9 @@ class mo01_nmx : public fb_parser
   std::string y_stream_id_{"nmx_ytrack"};
   std::string hit_stream_id_{"mon_hits"};
 
-  EventModel hists_model_;
-  EventModel track_model_;
-  EventModel hits_model_;
+  SharedEventModel hists_model_;
+  SharedEventModel track_model_;
+  SharedEventModel hits_model_;
 
   uint64_t spoofed_time_{0};
   bool started_{false};
@@ -2,6 +2,7 @@
 #include "senv_data_generated.h"
 
 #include <core/util/timer.h>
+#include <core/spill_pool.h>
 #include <core/util/logger.h>
 
 SenvParser::SenvParser()
@@ -30,9 +31,9 @@ SenvParser::SenvParser()
   root.set_enum(i++, r + "/SourceName");
   add_definition(root);
 
-  event_model_.add_value("channel", 3);
-  event_model_.add_trace("wave_form", {5000});
-  event_model_.add_trace("times", {5000});
+  event_model_.edit().add_value("channel", 3);
+  event_model_.edit().add_trace("wave_form", {5000});
+  event_model_.edit().add_trace("times", {5000});
 
   status_ = ProducerStatus::loaded | ProducerStatus::can_boot;
 }
@@ -42,7 +43,7 @@ StreamManifest SenvParser::stream_manifest() const
   StreamManifest ret;
   for (size_t i=0; i < 4; ++i) {
     auto sid = stream_id_base_ + std::to_string(i);
-    ret[sid].event_model = event_model_;
+    ret[sid].event_model = *event_model_;
     ret[sid].stats.branches.add(SettingMeta("native_time", SettingType::precise));
     ret[sid].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
     ret[sid].stats.branches.add(SettingMeta("senv_name", SettingType::text));
@@ -62,7 +63,7 @@ Setting SenvParser::settings() const
   set.set(Setting::boolean(r + "/FilterSourceName", filter_source_name_));
   set.set(Setting::text(r + "/SourceName", source_name_));
 
-  set.branches.add_a(TimeBasePlugin(event_model_.timebase).settings());
+  set.branches.add_a(TimeBasePlugin(event_model_->timebase).settings());
 
   set.enable_if_flag(!(status_ & booted), "preset");
   return set;
@@ -78,7 +79,7 @@ void SenvParser::settings(const Setting& settings)
 
   TimeBasePlugin tbs;
   tbs.settings(set.find({tbs.plugin_name()}));
-  event_model_.timebase = tbs.timebase();
+  event_model_.edit().timebase = tbs.timebase();
 }
 
 uint64_t SenvParser::stop(SpillQueue spill_queue)
@@ -158,7 +159,7 @@ uint64_t SenvParser::process_payload(SpillQueue spill_queue, void* msg)
   }
 
   auto sid = stream_id_base_ + std::to_string(channel);
-  auto run_spill = std::make_shared<Spill>(sid, Spill::Type::running);
+  auto run_spill = SpillPool::singleton().get(sid, Spill::Type::running);
   run_spill->state.branches.add(Setting::precise("native_time", Data->PacketTimestamp()));
   run_spill->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
   run_spill->state.branches.add(Setting::text("senv_name", source_name));
@@ -171,18 +172,24 @@ uint64_t SenvParser::process_payload(SpillQueue spill_queue, void* msg)
   if (event_count)
   {
     run_spill->event_model = event_model_;
-    run_spill->events.reserve(1, event_model_);
+    run_spill->events.reserve(1, *event_model_);
     auto& evt = run_spill->events.last();
     evt.set_time(Data->PacketTimestamp());
     evt.set_value(0, channel);
 
     bool timestamps_included = bool(Data->Timestamps());
 
+    auto& wave_form = evt.trace(0);
+    wave_form.resize(event_count);
     for (size_t i = 0; i < event_count; ++i)
+      wave_form[i] = Data->Values()->Get(i);
+
+    if (timestamps_included)
     {
-      evt.trace(0)[i] = Data->Values()->Get(i);
-      if (timestamps_included)
-        evt.trace(1)[i] = Data->Timestamps()->Get(i);
+      auto& times = evt.trace(1);
+      times.resize(event_count);
+      for (size_t i = 0; i < event_count; ++i)
+        times[i] = Data->Timestamps()->Get(i);
     }
     ++run_spill->events;
     run_spill->events.finalize();
@@ -37,7 +37,7 @@ class SenvParser : public fb_parser
   bool filter_source_name_{false};
   std::string source_name_;
 
-  EventModel event_model_;
+  SharedEventModel event_model_;
 
   bool started_{false};
 
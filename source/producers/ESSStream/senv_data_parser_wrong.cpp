@@ -2,6 +2,7 @@
 #include "senv_data_generated.h"
 
 #include <core/util/timer.h>
+#include <core/spill_pool.h>
 #include <core/util/logger.h>
 
 SenvParserWrong::SenvParserWrong()
@@ -30,7 +31,7 @@ SenvParserWrong::SenvParserWrong()
   root.set_enum(i++, r + "/SourceName");
   add_definition(root);
 
-  event_model_.add_value("channel", 3);
+  event_model_.edit().add_value("channel", 3);
 
   status_ = ProducerStatus::loaded | ProducerStatus::can_boot;
 }
@@ -40,7 +41,7 @@ StreamManifest SenvParserWrong::stream_manifest() const
   StreamManifest ret;
   for (size_t i=0; i < 4; ++i) {
     auto sid = stream_id_base_ + std::to_string(i);
-    ret[sid].event_model = event_model_;
+    ret[sid].event_model = *event_model_;
     ret[sid].stats.branches.add(SettingMeta("native_time", SettingType::precise));
     ret[sid].stats.branches.add(SettingMeta("dropped_buffers", SettingType::precise));
     ret[sid].stats.branches.add(SettingMeta("senv_name", SettingType::text));
@@ -60,7 +61,7 @@ Setting SenvParserWrong::settings() const
   set.set(Setting::boolean(r + "/FilterSourceName", filter_source_name_));
   set.set(Setting::text(r + "/SourceName", source_name_));
 
-  set.branches.add_a(TimeBasePlugin(event_model_.timebase).settings());
+  set.branches.add_a(TimeBasePlugin(event_model_->timebase).settings());
 
   set.enable_if_flag(!(status_ & booted), "preset");
   return set;
@@ -76,7 +77,7 @@ void SenvParserWrong::settings(const Setting& settings)
 
   TimeBasePlugin tbs;
   tbs.settings(set.find({tbs.plugin_name()}));
-  event_model_.timebase = tbs.timebase();
+  event_model_.edit().timebase = tbs.timebase();
 }
 
 uint64_t SenvParserWrong::stop(SpillQueue spill_queue)
@@ -155,7 +156,7 @@ uint64_t SenvParserWrong::process_payload(SpillQueue spill_queue, void* msg)
   }
 
   auto sid = stream_id_base_ + std::to_string(channel);
-  auto run_spill = std::make_shared<Spill>(sid, Spill::Type::running);
+  auto run_spill = SpillPool::singleton().get(sid, Spill::Type::running);
   run_spill->state.branches.add(Setting::precise("native_time", Data->PacketTimestamp()));
   run_spill->state.branches.add(Setting::precise("dropped_buffers", stats.dropped_buffers));
   run_spill->state.branches.add(Setting::text("senv_name", name));
@@ -165,7 +166,7 @@ uint64_t SenvParserWrong::process_payload(SpillQueue spill_queue, void* msg)
 
   size_t event_count = Data->Timestamps()->size();
   run_spill->event_model = event_model_;
-  run_spill->events.reserve(event_count, event_model_);
+  run_spill->events.reserve(event_count, *event_model_);
 
   for (size_t i=0; i < event_count; ++i)
   {
@@ -34,7 +34,7 @@ class SenvParserWrong : public fb_parser
 
   std::string stream_id_base_{"Senv"};
 
-  EventModel event_model_;
+  SharedEventModel event_model_;
 
   bool started_{false};
 
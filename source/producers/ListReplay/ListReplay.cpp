@@ -0,0 +1,257 @@
+#include <producers/ListReplay/ListReplay.h>
+#include <core/util/timer.h>
+
+#include <core/util/logger.h>
+
+ListReplay::ListReplay()
+{
+  std::string r{plugin_name()};
+
+  SettingMeta path(r + "/Path", SettingType::text, "First list mode file");
+  path.set_flag("file");
+  path.set_flag("preset");
+  path.set_val("wildcards", "List mode (*.daqlist)");
+  add_definition(path);
+
+  SettingMeta pf(r + "/Prefetch", SettingType::integer, "Spills decoded ahead per file");
+  pf.set_val("min", 1);
+  pf.set_val("max", 100000);
+  add_definition(pf);
+
+  SettingMeta th(r + "/Threads", SettingType::integer, "Files decoded ahead at once");
+  th.set_val("min", 1);
+  th.set_val("max", 64);
+  add_definition(th);
+
+  SettingMeta mq(r + "/MaxQueued", SettingType::integer, "Spills waiting for consumers");
+  mq.set_val("min", 1);
+  mq.set_val("max", 100000);
+  add_definition(mq);
+
+  int32_t i{0};
+  SettingMeta root(r, SettingType::stem);
+  root.set_flag("producer");
+  root.set_enum(i++, r + "/Path");
+  root.set_enum(i++, r + "/Prefetch");
+  root.set_enum(i++, r + "/Threads");
+  root.set_enum(i++, r + "/MaxQueued");
+  add_definition(root);
+
+  status_ = ProducerStatus::loaded | ProducerStatus::can_boot;
+}
+
+ListReplay::~ListReplay()
+{
+  daq_stop();
+  die();
+}
+
+StreamManifest ListReplay::stream_manifest() const
+{
+  return manifest_;
+}
+
+bool ListReplay::daq_start(SpillQueue out_queue)
+{
+  //a replay that ran to the end still leaves its thread to be joined
+  if (runner_.joinable())
+    daq_stop();
+
+  terminate_.store(false);
+  running_.store(true);
+  runner_ = std::thread(&ListReplay::worker_run, this, out_queue);
+
+  return true;
+}
+
+bool ListReplay::daq_stop()
+{
+  terminate_.store(true);
+
+  if (runner_.joinable())
+    runner_.join();
+  running_.store(false);
+
+  return true;
+}
+
+bool ListReplay::daq_running()
+{
+  return (running_.load());
+}
+
+Setting ListReplay::settings() const
+{
+  std::string r{plugin_name()};
+  auto set = get_rich_setting(r);
+
+  set.set(Setting::text(r + "/Path", path_));
+  set.set(Setting::integer(r + "/Prefetch", integer_t(prefetch_)));
+  set.set(Setting::integer(r + "/Threads", integer_t(threads_)));
+  set.set(Setting::integer(r + "/MaxQueued", integer_t(max_queued_)));
+
+  set.enable_if_flag(!(status_ & booted), "preset");
+  return set;
+}
+
+void ListReplay::settings(const Setting& settings)
+{
+  std::string r{plugin_name()};
+  auto set = enrich_and_toggle_presets(settings);
+
+  path_ = set.find({r + "/Path"}).get_text();
+  prefetch_ = std::max(integer_t(1), set.find({r + "/Prefetch"}).get_int());
+  threads_ = std::max(integer_t(1), set.find({r + "/Threads"}).get_int());
+  max_queued_ = std::max(integer_t(1), set.find({r + "/MaxQueued"}).get_int());
+}
+
+void ListReplay::boot()
+{
+  if (!(status_ & ProducerStatus::can_boot))
+  {
+    WARN("<ListReplay> Cannot boot ListReplay. Failed flag check (can_boot == 0)");
+    return;
+  }
+
+  status_ = ProducerStatus::loaded | ProducerStatus::can_boot;
+
+  //streams are described by the first spills of the recording
+  manifest_.clear();
+  try
+  {
+    ListReader reader(path_);
+    for (size_t i = 0; i < 256; ++i)
+    {
+      auto spill = reader.next();
+      if (!spill)
+        break;
+      if (spill->stream_id.empty())
+        continue;
+      auto& info = manifest_[spill->stream_id];
+      info.event_model = *spill->event_model;
+      for (const auto& s : spill->state.branches)
+        info.stats.branches.add(SettingMeta(s.id(), s.metadata().type()));
+    }
+  }
+  catch (std::exception& e)
+  {
+    ERR("<ListReplay> Cannot read '{}': {}", path_, e.what());
+    return;
+  }
+
+  INFO("<ListReplay> Booted with {} file(s) starting at {}",
+       ListReader::sequence(path_).size(), path_);
+  status_ = ProducerStatus::loaded | ProducerStatus::booted | ProducerStatus::can_run;
+}
+
+void ListReplay::die()
+{
+  status_ = ProducerStatus::loaded | ProducerStatus::can_boot;
+}
+
+void ListReplay::worker_run(SpillQueue spill_queue)
+{
+  auto files = ListReader::sequence(path_);
+  DBG("<ListReplay> Starting replay of {} file(s)", files.size());
+
+  Timer timer(true);
+  spills_ = 0;
+  events_ = 0;
+
+  std::deque<std::unique_ptr<Prefetch>> ahead;
+  size_t next {0};
+  auto fill = [&]()
+  {
+    while ((ahead.size() < threads_) && (next < files.size()))
+      ahead.emplace_back(new Prefetch(files[next++], prefetch_));
+  };
+
+  fill();
+  while (!terminate_.load() && !ahead.empty())
+  {
+    SpillPtr spill;
+    if (!ahead.front()->pop(spill))
+    {
+      ahead.pop_front();
+      fill();
+      continue;
+    }
+
+    //engine settings snapshots, the replaying engine adds its own
+    if (spill->stream_id.empty())
+      continue;
+
+    //go only as fast as the consumers, checking for stop now and then
+    while (!terminate_.load() &&
+        !spill_queue->wait_below(max_queued_, std::chrono::milliseconds(100)));
+
+    events_ += spill->events.size();
+    spills_++;
+    spill_queue->enqueue(spill);
+  }
+  ahead.clear();
+
+  INFO("<ListReplay> Replayed {} spills, {} events in {}",
+       spills_.load(), events_.load(), timer.elapsed_str());
+  running_.store(false);
+  //the engine need not wait out its poll to see we are done
+  spill_queue->notify();
+}
+
+ListReplay::Prefetch::Prefetch(std::string path, size_t depth)
+  : path_(path)
+  , depth_(depth)
+{
+  thread_ = std::thread(&ListReplay::Prefetch::run, this);
+}
+
+ListReplay::Prefetch::~Prefetch()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+}
+
+bool ListReplay::Prefetch::pop(SpillPtr& spill)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (spills_.empty() && !done_)
+    cond_.wait(lock);
+  if (spills_.empty())
+    return false;
+  spill = spills_.front();
+  spills_.pop_front();
+  cond_.notify_all();
+  return true;
+}
+
+void ListReplay::Prefetch::run()
+{
+  try
+  {
+    ListReader reader(path_);
+    while (true)
+    {
+      auto spill = reader.next();
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!spill || stop_)
+        break;
+      while ((spills_.size() >= depth_) && !stop_)
+        cond_.wait(lock);
+      spills_.push_back(spill);
+      cond_.notify_all();
+    }
+  }
+  catch (std::exception& e)
+  {
+    ERR("<ListReplay> Stopped reading '{}': {}", path_, e.what());
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_ = true;
+  cond_.notify_all();
+}
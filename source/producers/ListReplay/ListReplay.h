@@ -0,0 +1,80 @@
+#pragma once
+
+#include <core/producer.h>
+#include <core/list_file.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace DAQuiri;
+
+class ListReplay : public Producer
+{
+  public:
+    ListReplay();
+    ~ListReplay();
+
+    std::string plugin_name() const override { return "ListReplay"; }
+
+    void settings(const Setting&) override;
+    Setting settings() const override;
+
+    void boot() override;
+    void die() override;
+
+    StreamManifest stream_manifest() const override;
+
+    bool daq_start(SpillQueue out_queue) override;
+    bool daq_stop() override;
+    bool daq_running() override;
+
+  private:
+    //no copying
+    void operator=(ListReplay const&);
+    ListReplay(const ListReplay&);
+
+    //Acquisition threads, use as static functors
+    void worker_run(SpillQueue spill_queue);
+
+    //decodes one file ahead of the worker, in its own thread
+    class Prefetch
+    {
+      public:
+        Prefetch(std::string path, size_t depth);
+        ~Prefetch();
+
+        //blocks, false once the file is exhausted
+        bool pop(SpillPtr& spill);
+
+      private:
+        std::string path_;
+        size_t depth_;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::deque<SpillPtr> spills_;
+        bool done_ {false};
+        bool stop_ {false};
+        std::thread thread_;
+
+        void run();
+    };
+
+  protected:
+    std::atomic<bool> terminate_{false};
+    std::atomic<bool> running_{false};
+    std::thread runner_;
+
+    // cached params
+    std::string path_;
+    size_t prefetch_{64};   // spills decoded ahead per file
+    size_t threads_{2};     // files decoded ahead at once
+    size_t max_queued_{16}; // spills waiting in the engine queue
+
+    StreamManifest manifest_;
+
+    // runtime
+    std::atomic<uint64_t> spills_{0};
+    std::atomic<uint64_t> events_{0};
+};
@@ -1,5 +1,6 @@
 #include <producers/MockProducer/MockProducer.h>
 #include <core/util/timer.h>
+#include <core/spill_pool.h>
 
 #include <core/util/logger.h>
 
@@ -72,7 +73,7 @@ MockProducer::~MockProducer()
 StreamManifest MockProducer::stream_manifest() const
 {
   StreamManifest ret;
-  ret[stream_id_].event_model = event_definition_;
+  ret[stream_id_].event_model = *event_definition_;
   ret[stream_id_].stats.branches.add(SettingMeta("native_time", SettingType::floating));
   ret[stream_id_].stats.branches.add(SettingMeta("live_time", SettingType::floating));
   ret[stream_id_].stats.branches.add(SettingMeta("live_trigger", SettingType::floating));
@@ -121,7 +122,7 @@ Setting MockProducer::settings() const
   set.set(Setting::floating(r + "/Lambda", lambda_));
   set.set(Setting::floating(r + "/SpillLambda", spill_lambda_));
 
-  set.branches.add_a(TimeBasePlugin(event_definition_.timebase).settings());
+  set.branches.add_a(TimeBasePlugin(event_definition_->timebase).settings());
 
   set.set(Setting::integer(r + "/ValueCount", integer_t(val_defs_.size())));
   while (set.branches.has_a(Setting({r + "/Value", SettingType::stem})))
@@ -155,7 +156,7 @@ void MockProducer::settings(const Setting& settings)
   TimeBasePlugin tbs;
   tbs.settings(set.find({tbs.plugin_name()}));
   event_definition_ = EventModel();
-  event_definition_.timebase = tbs.timebase();
+  event_definition_.edit().timebase = tbs.timebase();
 
   uint16_t val_count_ = std::max(int(set.find({r + "/ValueCount"}).get_number()), 1);
   if (val_defs_.size() != val_count_)
@@ -176,7 +177,7 @@ void MockProducer::settings(const Setting& settings)
   }
 
   for (size_t i = 0; i < val_defs_.size(); ++i)
-    val_defs_[i].define(event_definition_);
+    val_defs_[i].define(event_definition_.edit());
 }
 
 void MockProducer::boot()
@@ -207,7 +208,7 @@ void MockProducer::worker_run(SpillQueue spill_queue)
 {
   DBG("<MockProducer> Starting run   "
       "  timebase {} ns   init_rate = {} cps   lambda = {}",
-      event_definition_.timebase.debug(), count_rate_, lambda_);
+      event_definition_->timebase.debug(), count_rate_, lambda_);
 
   Timer timer(true);
 
@@ -218,7 +219,7 @@ void MockProducer::worker_run(SpillQueue spill_queue)
     Timer::wait_s(spill_interval_);
 
     double seconds = timer.s();
-    double overshoot = ((event_definition_.timebase.to_sec(clock_) - seconds) / seconds * 100.0);
+    double overshoot = ((event_definition_->timebase.to_sec(clock_) - seconds) / seconds * 100.0);
     if (overshoot > 0)
       DBG("<MockProducer> Native clock overshoot {}%", overshoot);
   }
@@ -236,15 +237,15 @@ void MockProducer::add_hit(Spill& spill, uint64_t time)
 
 SpillPtr MockProducer::get_spill(Spill::Type t, double seconds)
 {
-  SpillPtr spill = std::make_shared<Spill>(stream_id_, t);
+  SpillPtr spill = SpillPool::singleton().get(stream_id_, t);
 
-  recent_pulse_time_ = clock_ = event_definition_.timebase.to_native(seconds * pow(10, 9));
+  recent_pulse_time_ = clock_ = event_definition_->timebase.to_native(seconds * pow(10, 9));
 
   if (t == Spill::Type::running)
     fill_events(spill, seconds);
   spill->events.finalize();
 
-  clock_ = event_definition_.timebase.to_native((seconds + spill_interval_) * pow(10, 9));
+  clock_ = event_definition_->timebase.to_native((seconds + spill_interval_) * pow(10, 9));
   fill_stats(*spill);
 
   return spill;
@@ -257,9 +258,9 @@ void MockProducer::fill_events(SpillPtr& spill, double seconds)
     rate *= exp(0.0 - lambda_ * seconds);
 
   uint32_t total_events = (rate * spill_interval_) * (1.0 - dead_);
-  double event_interval = event_definition_.timebase.to_native(spill_interval_ * pow(10, 9)) / total_events;
+  double event_interval = event_definition_->timebase.to_native(spill_interval_ * pow(10, 9)) / total_events;
 
-  spill->events.reserve(total_events, event_definition_);
+  spill->events.reserve(total_events, *event_definition_);
   double time_bonus{0};
   for (uint32_t i = 0; i < total_events; i++)
   {
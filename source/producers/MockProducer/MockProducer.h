@@ -51,7 +51,7 @@ class MockProducer : public Producer
 
     std::vector<ValueDefinition> val_defs_{1, ValueDefinition()};
 
-    EventModel event_definition_;
+    SharedEventModel event_definition_;
 
     // runtime
     std::default_random_engine gen_;
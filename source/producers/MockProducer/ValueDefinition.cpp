@@ -102,6 +102,7 @@ uint32_t ValueDefinition::generate_val()
 void ValueDefinition::make_trace(size_t index, Event& e, uint32_t val)
 {
   auto& trc = e.trace(index);
+  trc.assign(trace_length_, 0);
 
   size_t onset = double(trc.size()) * trace_onset_;
   size_t peak = double(trc.size()) * (trace_onset_ + trace_risetime_);
@@ -3,6 +3,7 @@
 
 #include <producers/DetectorIndex/DetectorIndex.h>
 #include <producers/DummyDevice/DummyDevice.h>
+#include <producers/ListReplay/ListReplay.h>
 #include <producers/MockProducer/MockProducer.h>
 #include <producers/ESSStream/ESSStream.h>
 
@@ -11,5 +12,6 @@ void producers_autoreg()
     DAQUIRI_REGISTER_PRODUCER(DetectorIndex)
     DAQUIRI_REGISTER_PRODUCER(DummyDevice)
     DAQUIRI_REGISTER_PRODUCER(ESSStream)
+    DAQUIRI_REGISTER_PRODUCER(ListReplay)
     DAQUIRI_REGISTER_PRODUCER(MockProducer)
 }
@@ -43,7 +43,7 @@ TEST(FilterBlock, ConfigureValid)
   h.filters_[0].name_ = "val";
 
   Spill s;
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
 
   h.configure(s);
   EXPECT_TRUE(h.valid);
@@ -57,7 +57,7 @@ TEST(FilterBlock, ConfigureInvalid)
   h.filters_[0].name_ = "val2";
 
   Spill s;
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
 
   h.configure(s);
   EXPECT_FALSE(h.valid);
@@ -73,10 +73,10 @@ TEST(FilterBlock, AcceptValid)
   h.filters_[0].max_ = 42;
 
   Spill s;
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   h.configure(s);
 
-  Event e(s.event_model);
+  Event e(*s.event_model);
 
   e.set_value(0, 6);
   EXPECT_FALSE(h.accept(e));
@@ -89,6 +89,10 @@ TEST(FilterBlock, AcceptValid)
 
   e.set_value(0, 43);
   EXPECT_FALSE(h.accept(e));
+
+  h.preselected = true;
+  EXPECT_TRUE(h.accept(e));
+  EXPECT_FALSE(h.passes(e));
 }
 
 TEST(FilterBlock, InvalidAcceptsAll)
@@ -101,10 +105,10 @@ TEST(FilterBlock, InvalidAcceptsAll)
   h.filters_[0].max_ = 42;
 
   Spill s;
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   h.configure(s);
 
-  Event e(s.event_model);
+  Event e(*s.event_model);
 
   e.set_value(0, 6);
   EXPECT_TRUE(h.accept(e));
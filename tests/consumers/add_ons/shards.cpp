@@ -0,0 +1,39 @@
+#include "gtest_color_print.h"
+#include <consumers/add_ons/shards.h>
+#include <atomic>
+
+class ShardPool : public TestBase
+{
+  protected:
+    DAQuiri::ShardPool pool;
+};
+
+TEST_F(ShardPool, RunsEveryIndex)
+{
+  pool.resize(3);
+  EXPECT_EQ(pool.size(), 3UL);
+
+  std::vector<size_t> hits(4, 0);
+  std::function<void(size_t)> job = [&hits](size_t i) { hits[i]++; };
+  for (size_t round = 0; round < 100; ++round)
+    pool.run(job);
+  EXPECT_EQ(hits, std::vector<size_t>(4, 100));
+}
+
+TEST_F(ShardPool, Resize)
+{
+  std::atomic<size_t> calls {0};
+  std::function<void(size_t)> job = [&calls](size_t) { calls++; };
+
+  pool.run(job);
+  EXPECT_EQ(calls, 1UL);
+
+  pool.resize(2);
+  pool.run(job);
+  EXPECT_EQ(calls, 4UL);
+
+  pool.resize(0);
+  EXPECT_EQ(pool.size(), 0UL);
+  pool.run(job);
+  EXPECT_EQ(calls, 5UL);
+}
@@ -20,7 +20,7 @@ TEST(Status, ExtractDefault)
   EXPECT_EQ(s.producer_time, spill.time);
   EXPECT_GE(s.consumer_time, s.producer_time);
   EXPECT_TRUE(s.stats.empty());
-  EXPECT_EQ(s.timebase, spill.event_model.timebase);
+  EXPECT_EQ(s.timebase, spill.event_model->timebase);
 }
 
 TEST(Status, ExtractWithTimes)
@@ -18,11 +18,11 @@ TEST(ValueFilter, Configure)
   h.name_ = "val2";
   EXPECT_FALSE(h.valid());
 
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   h.configure(s);
   EXPECT_FALSE(h.valid());
 
-  s.event_model.add_value("val2", 100);
+  s.event_model.edit().add_value("val2", 100);
   h.configure(s);
   EXPECT_TRUE(h.valid());
 }
@@ -37,11 +37,11 @@ TEST(ValueFilter, ConfiguredFilters)
   h.min_ = 7;
   h.max_ = 42;
 
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   h.configure(s);
   EXPECT_TRUE(h.valid());
 
-  Event e(s.event_model);
+  Event e(*s.event_model);
 
   e.set_value(0, 3);
   EXPECT_FALSE(h.accept(e));
@@ -69,11 +69,11 @@ TEST(ValueFilter, UnconfiguredAcceptsAll)
   h.min_ = 7;
   h.max_ = 42;
 
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   h.configure(s);
   EXPECT_FALSE(h.valid());
 
-  Event e(s.event_model);
+  Event e(*s.event_model);
 
   e.set_value(0, 3);
   EXPECT_TRUE(h.accept(e));
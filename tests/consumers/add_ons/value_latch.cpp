@@ -22,21 +22,21 @@ TEST_F(ValueLatch, Configure)
 {
   EXPECT_FALSE(vl.valid());
 
-  s.event_model.add_value("val2", 100);
+  s.event_model.edit().add_value("val2", 100);
   vl.configure(s);
   EXPECT_FALSE(vl.valid());
 
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   vl.configure(s);
   EXPECT_TRUE(vl.valid());
 }
 
 TEST_F(ValueLatch, ExtractNoDownsample)
 {
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   vl.configure(s);
 
-  DAQuiri::Event e(s.event_model);
+  DAQuiri::Event e(*s.event_model);
   size_t result;
 
   e.set_value(0, 3);
@@ -46,11 +46,11 @@ TEST_F(ValueLatch, ExtractNoDownsample)
 
 TEST_F(ValueLatch, ExtractWithDownsample)
 {
-  s.event_model.add_value("val", 100);
+  s.event_model.edit().add_value("val", 100);
   vl.configure(s);
   vl.downsample = 2;
 
-  DAQuiri::Event e(s.event_model);
+  DAQuiri::Event e(*s.event_model);
   size_t result;
 
   e.set_value(0, 16);
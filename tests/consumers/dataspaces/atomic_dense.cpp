@@ -0,0 +1,167 @@
+#include "gtest_color_print.h"
+#include <consumers/dataspaces/atomic_dense.h>
+#include <thread>
+
+class AtomicDense : public TestBase
+{
+  protected:
+    DAQuiri::AtomicDense d{2};
+};
+
+TEST_F(AtomicDense, Init)
+{
+  EXPECT_TRUE(d.empty());
+  EXPECT_EQ(d.dimensions(), 2);
+  EXPECT_EQ(d.total_count(), 0);
+}
+
+TEST_F(AtomicDense, AddOneGrows)
+{
+  d.add_one({0, 0});
+  EXPECT_FALSE(d.empty());
+  EXPECT_EQ(d.total_count(), 1);
+
+  d.add_one({3, 200});
+  d.add_one({3, 200});
+  EXPECT_EQ(d.get({0, 0}), 1);
+  EXPECT_EQ(d.get({3, 200}), 2);
+  EXPECT_EQ(d.total_count(), 3);
+}
+
+TEST_F(AtomicDense, Add)
+{
+  d.add({{1, 2}, 3});
+  d.add({{1, 2}, 5});
+  EXPECT_EQ(d.get({1, 2}), 8);
+  EXPECT_EQ(d.total_count(), 8);
+}
+
+TEST_F(AtomicDense, ConcurrentOutsideExtent)
+{
+  d.reserve({3, 3});
+  EXPECT_TRUE(d.add_concurrent({3, 3}));
+  EXPECT_FALSE(d.add_concurrent({4, 0}));
+  EXPECT_FALSE(d.add_concurrent({0}));
+}
+
+TEST_F(AtomicDense, ReserveBudget)
+{
+  //a declared 16-bit range on both dimensions is not allocated
+  d.reserve({65535, 65535});
+  EXPECT_EQ(d.capacity(), DAQuiri::Coords({0, 0}));
+
+  d.reserve({100, 100});
+  EXPECT_EQ(d.capacity(), DAQuiri::Coords({101, 101}));
+  EXPECT_TRUE(d.add_concurrent({100, 100}));
+
+  //past the budget, growth is exact rather than rounded up
+  d.reserve_budget = 0;
+  d.add_one({200, 3});
+  EXPECT_EQ(d.capacity(), DAQuiri::Coords({201, 101}));
+  EXPECT_EQ(d.get({100, 100}), 1);
+  EXPECT_EQ(d.get({200, 3}), 1);
+}
+
+TEST_F(AtomicDense, Range)
+{
+  d.add({{1, 2}, 3});
+  d.add({{5, 0}, 4});
+
+  auto all = d.range({});
+  ASSERT_EQ(all->size(), 2UL);
+  EXPECT_EQ(all->at(0).first, DAQuiri::Coords({1, 2}));
+  EXPECT_EQ(all->at(0).second, 3);
+  EXPECT_EQ(all->at(1).first, DAQuiri::Coords({5, 0}));
+
+  auto some = d.range({{0, 2}, {0, 10}});
+  ASSERT_EQ(some->size(), 1UL);
+  EXPECT_EQ(some->at(0).second, 3);
+}
+
+TEST_F(AtomicDense, RangeBinned)
+{
+  d.add_one({0, 0});
+  d.add_one({1, 1});
+  d.add_one({3, 2});
+  d.add({{2, 3}, 2});
+
+  auto full = d.range_binned({{0, 3}, {0, 3}}, {0, 0});
+  EXPECT_EQ(full->size(), 4UL);
+
+  auto binned = d.range_binned({{0, 3}, {0, 3}}, {2, 2});
+  ASSERT_EQ(binned->size(), 2UL);
+  EXPECT_EQ(binned->at(0).first, DAQuiri::Coords({0, 0}));
+  EXPECT_EQ(binned->at(0).second, 2);
+  EXPECT_EQ(binned->at(1).first, DAQuiri::Coords({1, 1}));
+  EXPECT_EQ(binned->at(1).second, 3);
+
+  //ranges past the largest bins seen
+  auto wide = d.range_binned({{2, 9}, {2, 9}}, {1, 1});
+  ASSERT_EQ(wide->size(), 1UL);
+  EXPECT_EQ(wide->at(0).first, DAQuiri::Coords({0, 0}));
+  EXPECT_EQ(wide->at(0).second, 3);
+
+  //no ranges, binned over the bins seen
+  auto all = d.range_binned({}, {1, 1});
+  ASSERT_EQ(all->size(), 1UL);
+  EXPECT_EQ(all->at(0).second, 5);
+}
+
+TEST_F(AtomicDense, Clear)
+{
+  d.add({{1, 2}, 3});
+  d.clear();
+  EXPECT_TRUE(d.empty());
+  EXPECT_EQ(d.total_count(), 0);
+  EXPECT_EQ(d.get({1, 2}), 0);
+}
+
+TEST_F(AtomicDense, Clone)
+{
+  d.add({{1, 2}, 3});
+  auto c = std::shared_ptr<DAQuiri::AtomicDense>(d.clone());
+  d.add_one({1, 2});
+  EXPECT_EQ(c->get({1, 2}), 3);
+  EXPECT_EQ(c->total_count(), 3);
+}
+
+//not a timing assertion, reports fill rate against a single thread
+TEST_F(AtomicDense, ConcurrentFill)
+{
+  const size_t per_thread = 10000;
+  const size_t threads = 4;
+  d.reserve({255, 255});
+
+  DAQuiri::AtomicDense serial(2);
+  auto fill = [](DAQuiri::AtomicDense& into, size_t seed, size_t n)
+  {
+    DAQuiri::Coords c{0, 0};
+    for (size_t i = 0; i < n; ++i)
+    {
+      c[0] = (seed + i * 7919) & 0xFF;
+      c[1] = (seed + i * 104729) & 0xFF;
+      into.add_concurrent(c);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t)
+    workers.emplace_back(fill, std::ref(d), t, per_thread);
+  for (auto& w : workers)
+    w.join();
+
+  serial.reserve({255, 255});
+  for (size_t t = 0; t < threads; ++t)
+    fill(serial, t, per_thread);
+
+  //totals are tallied by the callers
+  EXPECT_EQ(d.total_count(), 0);
+  d.count_concurrent(threads * per_thread);
+  d.recalc_axes();
+  EXPECT_EQ(d.total_count(), threads * per_thread);
+  EXPECT_FALSE(d.empty());
+
+  for (size_t x = 0; x < 256; ++x)
+    for (size_t y = 0; y < 256; ++y)
+      ASSERT_EQ(d.get({x, y}), serial.get({x, y}));
+}
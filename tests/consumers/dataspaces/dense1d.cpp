@@ -43,6 +43,25 @@ TEST_F(Dense1D, Add)
   EXPECT_EQ(d.get({0}), 8);
 }
 
+TEST_F(Dense1D, AddTrace)
+{
+  std::vector<uint32_t> trace {1, 2, 0, 4, 5, 0, 0, 0};
+  d.add_trace(trace.data(), trace.size());
+  EXPECT_EQ(d.get({0}), 1);
+  EXPECT_EQ(d.get({3}), 4);
+  EXPECT_EQ(d.get({4}), 5);
+  EXPECT_EQ(d.total_count(), 12);
+  d.recalc_axes();
+  EXPECT_EQ(d.axis(0).domain.size(), 5UL);
+
+  d.add_trace(trace.data(), trace.size(), 1);
+  EXPECT_EQ(d.get({0}), 4);
+  EXPECT_EQ(d.get({1}), 6);
+  EXPECT_EQ(d.get({2}), 5);
+  EXPECT_EQ(d.get({3}), 4);
+  EXPECT_EQ(d.total_count(), 24);
+}
+
 TEST_F(Dense1D, Clear)
 {
   d.add({{0}, 3});
@@ -88,6 +107,10 @@ TEST_F(Dense1D, CalcAxes)
   EXPECT_EQ(d.axis(0).domain.size(), 1UL);
   d.recalc_axes();
   EXPECT_EQ(d.axis(0).domain.size(), 2UL);
+
+  d.clear();
+  d.recalc_axes();
+  EXPECT_EQ(d.axis(0).domain.size(), 1UL);
 }
 
 TEST_F(Dense1D, SaveLoadEmpty)
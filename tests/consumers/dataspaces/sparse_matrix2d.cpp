@@ -1,4 +1,5 @@
 #include "gtest_color_print.h"
+#include <map>
 
 #include <consumers/dataspaces/sparse_matrix2d.h>
 
@@ -68,6 +69,39 @@ TEST_F(SparseMatrix2D, Range)
   EXPECT_EQ(d.range({})->at(1).first[1], 1UL);
 }
 
+TEST_F(SparseMatrix2D, RangeBinned)
+{
+  d.add_one({0, 0});
+  d.add_one({1, 1});
+  d.add_one({3, 2});
+  d.add({{2, 3}, 2});
+
+  auto full = d.range_binned({{0, 3}, {0, 3}}, {0, 0});
+  EXPECT_EQ(full->size(), 4UL);
+
+  auto binned = d.range_binned({{0, 3}, {0, 3}}, {2, 2});
+  ASSERT_EQ(binned->size(), 2UL);
+  EXPECT_EQ(binned->at(0).first[0], 0UL);
+  EXPECT_EQ(binned->at(0).first[1], 0UL);
+  EXPECT_EQ(binned->at(0).second, 2);
+  EXPECT_EQ(binned->at(1).first[0], 1UL);
+  EXPECT_EQ(binned->at(1).first[1], 1UL);
+  EXPECT_EQ(binned->at(1).second, 3);
+
+  auto sub = d.range_binned({{2, 3}, {2, 3}}, {1, 1});
+  ASSERT_EQ(sub->size(), 1UL);
+  EXPECT_EQ(sub->at(0).first[0], 0UL);
+  EXPECT_EQ(sub->at(0).first[1], 0UL);
+  EXPECT_EQ(sub->at(0).second, 3);
+
+  //unbinned tiles are bins, still relative to range start
+  auto offset = d.range_binned({{2, 3}, {2, 3}}, {0, 0});
+  ASSERT_EQ(offset->size(), 2UL);
+  std::map<DAQuiri::Coords, PreciseFloat> tiles(offset->begin(), offset->end());
+  EXPECT_EQ(tiles[DAQuiri::Coords({1, 0})], 1);
+  EXPECT_EQ(tiles[DAQuiri::Coords({0, 1})], 2);
+}
+
 TEST_F(SparseMatrix2D, Clone)
 {
   d.add_one({0, 0});
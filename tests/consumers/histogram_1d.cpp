@@ -9,9 +9,9 @@ class Histogram1D : public TestBase
       h.set_attribute(DAQuiri::Setting::text("stream_id", "stream"));
       h.set_attribute(DAQuiri::Setting::text("value_latch/value_id", "val"));
 
-      s.event_model.add_value("val", 100);
-      s.event_model.add_value("val2", 100);
-      s.events.reserve(3, s.event_model);
+      s.event_model.edit().add_value("val", 100);
+      s.event_model.edit().add_value("val2", 100);
+      s.events.reserve(3, *s.event_model);
       s.events.last().set_value(0, 0);
       s.events.last().set_value(1, 0);
       ++s.events;
@@ -94,6 +94,19 @@ TEST_F(Histogram1D, FilterByValue)
   h.push_spill(s);
 
   EXPECT_EQ(h.metadata().get_attribute("total_count").get_number(), 1);
+  EXPECT_EQ(h.profile().events_accepted, 1UL);
+  EXPECT_EQ(h.profile().events_rejected, 2UL);
+
+  auto md = h.metadata();
+  auto attr = md.get_attribute("profile_accepted");
+  EXPECT_EQ(attr.get_number(), 1);
+  EXPECT_TRUE(attr.metadata().has_flag("readonly"));
+  EXPECT_EQ(md.get_attribute("profile_rejected").get_number(), 2);
+
+  nlohmann::json j = md;
+  DAQuiri::ConsumerMetadata saved = j;
+  EXPECT_FALSE(saved.get_attribute("profile_accepted"));
+  EXPECT_TRUE(saved.get_attribute("total_count"));
 }
 
 TEST_F(Histogram1D, Clone)
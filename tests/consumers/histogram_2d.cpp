@@ -1,4 +1,5 @@
 #include "gtest_color_print.h"
+#include "sharded_spill.h"
 #include <consumers/histogram_2d.h>
 
 class Histogram2D : public TestBase
@@ -16,10 +17,10 @@ class Histogram2D : public TestBase
       vy.set_text("y");
       h.set_attribute(vy);
 
-      s.event_model.add_value("x", 100);
-      s.event_model.add_value("y", 100);
-      s.event_model.add_value("filter_val", 100);
-      s.events.reserve(3, s.event_model);
+      s.event_model.edit().add_value("x", 100);
+      s.event_model.edit().add_value("y", 100);
+      s.event_model.edit().add_value("filter_val", 100);
+      s.events.reserve(3, *s.event_model);
 
       s.events.last().set_value(0, 0);
       s.events.last().set_value(1, 0);
@@ -36,6 +37,18 @@ class Histogram2D : public TestBase
       s.events.finalize();
     }
 
+    //pushes s and enough events to be sharded into both h and other
+    void push_big(DAQuiri::Histogram2D& other)
+    {
+      DAQuiri::Spill big{"stream", DAQuiri::Spill::Type::running};
+      big.event_model = s.event_model;
+      fill_strided(big, 2);
+      h.push_spill(s);
+      h.push_spill(big);
+      other.push_spill(s);
+      other.push_spill(big);
+    }
+
     DAQuiri::Histogram2D h;
     DAQuiri::Spill s{"stream", DAQuiri::Spill::Type::start};
 };
@@ -128,3 +141,27 @@ TEST_F(Histogram2D, Clone)
   EXPECT_EQ(data->rbegin()->first[1], 2UL);
   EXPECT_EQ(data->rbegin()->second, 2);
 }
+
+TEST_F(Histogram2D, ShardedMatchesSerial)
+{
+  auto sharded = std::shared_ptr<DAQuiri::Histogram2D>(h.clone());
+  sharded->set_attribute(DAQuiri::Setting::integer("shards", 4));
+  push_big(*sharded);
+
+  EXPECT_EQ(sharded->metadata().get_attribute("total_count").get_number(), 20003);
+  EXPECT_EQ(sharded->profile().events_accepted, 20003UL);
+
+  expect_same_bins(*h.data(), *sharded->data());
+}
+
+TEST_F(Histogram2D, DenseShardedMatchesSerial)
+{
+  auto sharded = std::shared_ptr<DAQuiri::Histogram2D>(h.clone());
+  sharded->set_attribute(DAQuiri::Setting::boolean("dense", true));
+  sharded->set_attribute(DAQuiri::Setting::integer("shards", 4));
+  push_big(*sharded);
+
+  EXPECT_EQ(sharded->metadata().get_attribute("total_count").get_number(), 20003);
+
+  expect_same_bins(*h.data(), *sharded->data());
+}
@@ -1,4 +1,5 @@
 #include "gtest_color_print.h"
+#include "sharded_spill.h"
 #include <consumers/histogram_3d.h>
 
 class Histogram3D : public TestBase
@@ -20,11 +21,11 @@ class Histogram3D : public TestBase
       vz.set_text("z");
       h.set_attribute(vz);
 
-      s.event_model.add_value("x", 100);
-      s.event_model.add_value("y", 100);
-      s.event_model.add_value("z", 100);
-      s.event_model.add_value("filter_val", 100);
-      s.events.reserve(3, s.event_model);
+      s.event_model.edit().add_value("x", 100);
+      s.event_model.edit().add_value("y", 100);
+      s.event_model.edit().add_value("z", 100);
+      s.event_model.edit().add_value("filter_val", 100);
+      s.events.reserve(3, *s.event_model);
 
       s.events.last().set_value(0, 0);
       s.events.last().set_value(1, 0);
@@ -140,3 +141,28 @@ TEST_F(Histogram3D, Clone)
   EXPECT_EQ(data->rbegin()->first[2], 2UL);
   EXPECT_EQ(data->rbegin()->second, 2);
 }
+
+TEST_F(Histogram3D, ShardedMatchesSerial)
+{
+  DAQuiri::Spill big{"stream", DAQuiri::Spill::Type::running};
+  big.event_model = s.event_model;
+  fill_strided(big, 3);
+
+  auto sharded = std::shared_ptr<DAQuiri::Histogram3D>(h.clone());
+  sharded->set_attribute(DAQuiri::Setting::integer("shards", 4));
+  sharded->set_attribute(DAQuiri::Setting::integer("shard_merge", 8));
+
+  h.push_spill(s);
+  h.push_spill(big);
+  sharded->push_spill(s);
+
+  // partials are held back until the spill ends
+  sharded->push_spill(big, 0, 10000, nullptr);
+  EXPECT_LT(sharded->data()->total_count(), 10003);
+  sharded->push_spill(big, 10000, 20000, nullptr);
+
+  EXPECT_EQ(sharded->metadata().get_attribute("total_count").get_number(), 20003);
+  EXPECT_EQ(sharded->profile().events_accepted, 20003UL);
+
+  expect_same_bins(*h.data(), *sharded->data());
+}
@@ -20,11 +20,11 @@ class Image2D : public TestBase
       vi.set_text("i");
       h.set_attribute(vi);
 
-      s.event_model.add_value("x", 100);
-      s.event_model.add_value("y", 100);
-      s.event_model.add_value("i", 100);
-      s.event_model.add_value("filter_val", 100);
-      s.events.reserve(3, s.event_model);
+      s.event_model.edit().add_value("x", 100);
+      s.event_model.edit().add_value("y", 100);
+      s.event_model.edit().add_value("i", 100);
+      s.event_model.edit().add_value("filter_val", 100);
+      s.events.reserve(3, *s.event_model);
 
       s.events.last().set_value(0, 0);
       s.events.last().set_value(1, 0);
@@ -9,22 +9,16 @@ class Prebinned1D : public TestBase
       h.set_attribute(DAQuiri::Setting::text("stream_id", "stream"));
       h.set_attribute(DAQuiri::Setting::text("trace_id", "trace"));
 
-      s.event_model.add_value("val", 100);
-      s.event_model.add_trace("trace", {3});
-      s.events.reserve(3, s.event_model);
-      s.events.last().trace(0)[0] = 1;
-      s.events.last().trace(0)[1] = 0;
-      s.events.last().trace(0)[2] = 1;
+      s.event_model.edit().add_value("val", 100);
+      s.event_model.edit().add_trace("trace", {3});
+      s.events.reserve(3, *s.event_model);
+      s.events.last().trace(0) = {1, 0, 1};
       s.events.last().set_value(0, 0);
       ++s.events;
-      s.events.last().trace(0)[0] = 0;
-      s.events.last().trace(0)[1] = 1;
-      s.events.last().trace(0)[2] = 0;
+      s.events.last().trace(0) = {0, 1, 0};
       s.events.last().set_value(0, 15);
       ++s.events;
-      s.events.last().trace(0)[0] = 1;
-      s.events.last().trace(0)[1] = 0;
-      s.events.last().trace(0)[2] = 0;
+      s.events.last().trace(0) = {1, 0, 0};
       s.events.last().set_value(0, 30);
       ++s.events;
 
@@ -0,0 +1,32 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <core/spill.h>
+#include <core/dataspace.h>
+
+// Fills spill with count events, enough to be sharded, whose first
+// dimensions values step through coprime strides over small ranges.
+// Uses the spill's event model.
+inline void fill_strided(DAQuiri::Spill& spill, size_t dimensions,
+                         uint32_t count = 20000)
+{
+  const uint32_t steps[] {7919, 104729, 3571};
+  const uint32_t ranges[] {61, 37, 23};
+  spill.events.reserve(count, *spill.event_model);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    for (size_t d = 0; d < dimensions; ++d)
+      spill.events.last().set_value(d, (i * steps[d]) % ranges[d]);
+    ++spill.events;
+  }
+  spill.events.finalize();
+}
+
+// Bin by bin, backends may list bins in different orders
+inline void expect_same_bins(const DAQuiri::Dataspace& expected,
+                             const DAQuiri::Dataspace& actual)
+{
+  auto entries = expected.range({});
+  ASSERT_EQ(entries->size(), actual.range({})->size());
+  for (const auto& e : *entries)
+    EXPECT_EQ(actual.get(e.first), e.second);
+}
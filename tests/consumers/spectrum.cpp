@@ -14,7 +14,12 @@ class MockSpectrumDataspace : public DAQuiri::Dataspace
     void add(const DAQuiri::Entry& e) override { total_count_ += e.second; }
     void add_one(const DAQuiri::Coords&) override { total_count_++; }
     PreciseFloat get(const DAQuiri::Coords&) const override { return 0; }
-    DAQuiri::EntryList range(std::vector<DAQuiri::Pair>) const override { return DAQuiri::EntryList(); }
+    DAQuiri::EntryList range(std::vector<DAQuiri::Pair>) const override
+    {
+      auto ret = std::make_shared<DAQuiri::EntryList_t>();
+      ret->push_back({DAQuiri::Coords(), total_count_});
+      return ret;
+    }
     void recalc_axes() override {}
 
     void export_csv(std::ostream&) const override {}
@@ -271,3 +276,54 @@ TEST_F(Spectrum, PeriodicClear)
   m.push_spill(s);
   EXPECT_EQ(m.metadata().get_attribute("total_count").get_number(), 3);
 }
+
+TEST_F(Spectrum, PeriodicHistory)
+{
+  m.set_attribute(DAQuiri::Setting::boolean("periodic_trigger/enabled", true));
+  m.set_attribute(DAQuiri::Setting("periodic_trigger/time_out", std::chrono::seconds(2)));
+  m.set_attribute(DAQuiri::Setting::integer("history_frames", 2));
+
+  s.events.reserve(3, DAQuiri::Event(DAQuiri::EventModel()));
+  ++s.events;
+  ++s.events;
+  ++s.events;
+  s.events.finalize();
+
+  auto start = s.time;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    m.push_spill(s);
+    s.time += std::chrono::seconds(1);
+  }
+  EXPECT_EQ(m.metadata().get_attribute("total_count").get_number(), 3);
+  ASSERT_EQ(m.frames(), 1UL);
+  EXPECT_EQ(m.frame(0).data->total_count(), 9);
+  EXPECT_EQ(m.frame(0).start, start);
+  EXPECT_EQ(m.frame(0).end, start + std::chrono::seconds(3));
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    m.push_spill(s);
+    s.time += std::chrono::seconds(1);
+  }
+  EXPECT_EQ(m.metadata().get_attribute("total_count").get_number(), 3);
+  ASSERT_EQ(m.frames(), 2UL);
+  EXPECT_EQ(m.frame(0).data->total_count(), 6);
+  EXPECT_EQ(m.frame(1).data->total_count(), 9);
+  EXPECT_EQ(m.frame_sum(2)->total_count(), 15);
+
+  auto diff = m.frame_diff(0, 1);
+  ASSERT_EQ(diff->size(), 1UL);
+  EXPECT_EQ(diff->front().second, -3);
+  EXPECT_THROW(m.frame(2), std::runtime_error);
+
+  //the oldest is dropped once the ring is full
+  for (size_t i = 0; i < 2; ++i)
+  {
+    m.push_spill(s);
+    s.time += std::chrono::seconds(1);
+  }
+  ASSERT_EQ(m.frames(), 2UL);
+  EXPECT_EQ(m.frame(0).data->total_count(), 6);
+  EXPECT_EQ(m.frame(1).data->total_count(), 6);
+}
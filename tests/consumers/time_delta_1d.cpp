@@ -10,8 +10,8 @@ class TimeDelta1D : public TestBase
       h.set_attribute(DAQuiri::Setting::floating("time_resolution", 1));
       h.set_attribute(DAQuiri::Setting::integer("time_units", 0));
 
-      s.event_model.add_value("val", 100);
-      s.events.reserve(3, s.event_model);
+      s.event_model.edit().add_value("val", 100);
+      s.events.reserve(3, *s.event_model);
       s.events.last().set_time(10);
       s.events.last().set_value(0, 0);
       ++s.events;
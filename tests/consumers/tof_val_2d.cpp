@@ -12,9 +12,9 @@ class TOFVal2D : public TestBase
       h.set_attribute(DAQuiri::Setting::integer("time_units", 0));
 
       s.state.branches.add_a(DAQuiri::Setting::floating("pulse_time", 10));
-      s.event_model.add_value("val", 100);
-      s.event_model.add_value("val2", 100);
-      s.events.reserve(3, s.event_model);
+      s.event_model.edit().add_value("val", 100);
+      s.event_model.edit().add_value("val2", 100);
+      s.events.reserve(3, *s.event_model);
       s.events.last().set_time(10);
       s.events.last().set_value(0, 0);
       s.events.last().set_value(1, 0);
@@ -12,9 +12,9 @@ class TOFVal2DCorrelate : public TestBase
       h.set_attribute(DAQuiri::Setting::integer("time_units", 0));
       h.set_attribute(DAQuiri::Setting::text("chopper_stream_id", "chopper_stream"));
 
-      s.event_model.add_value("val", 100);
-      s.event_model.add_value("val2", 100);
-      s.events.reserve(5, s.event_model);
+      s.event_model.edit().add_value("val", 100);
+      s.event_model.edit().add_value("val2", 100);
+      s.events.reserve(5, *s.event_model);
       s.events.last().set_time(0);
       s.events.last().set_value(0, 0);
       s.events.last().set_value(1, 0);
@@ -37,7 +37,7 @@ class TOFVal2DCorrelate : public TestBase
       ++s.events;
       s.events.finalize();
 
-      cs.events.reserve(4, cs.event_model);
+      cs.events.reserve(4, *cs.event_model);
       cs.events.last().set_time(0);
       ++cs.events;
       cs.events.last().set_time(10);
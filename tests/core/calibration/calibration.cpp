@@ -209,6 +209,23 @@ TEST_F(Calibration, equals)
   c2.function("Polynomial" , {5.0});
 }
 
+TEST_F(Calibration, equals_x_offset)
+{
+  DAQUIRI_REGISTER_COEF_FUNCTION(DAQuiri::Polynomial);
+
+  DAQuiri::Calibration c({"v1"}, {"v2"});
+  DAQuiri::Calibration c2({"v1"}, {"v2"});
+  c.function("Polynomial" , {5.0, 2.0, 1.0});
+  c2.function("Polynomial" , {5.0, 2.0, 1.0});
+  EXPECT_EQ(c, c2);
+
+  auto shifted = DAQuiri::CoefFunctionFactory::singleton().create_copy(c.function());
+  shifted->x_offset({3.0});
+  c2.function(shifted);
+  EXPECT_NE(c, c2);
+  EXPECT_NE(c2, c);
+}
+
 TEST_F(Calibration, transform)
 {
   DAQUIRI_REGISTER_COEF_FUNCTION(DAQuiri::Polynomial);
@@ -0,0 +1,95 @@
+#include "gtest_color_print.h"
+#include <core/calibration/compiled_calibration.h>
+#include <core/calibration/polynomial.h>
+
+class CompiledCalibration : public TestBase
+{
+};
+
+TEST_F(CompiledCalibration, InitDefault)
+{
+  DAQuiri::CompiledCalibration cc;
+  EXPECT_FALSE(cc.valid());
+  EXPECT_FALSE(cc.flat());
+  EXPECT_DOUBLE_EQ(cc(3.0), 3.0);
+}
+
+TEST_F(CompiledCalibration, InitEmptyPolynomial)
+{
+  DAQuiri::CompiledCalibration cc(std::make_shared<DAQuiri::Polynomial>());
+  EXPECT_FALSE(cc.valid());
+  EXPECT_FALSE(cc.flat());
+}
+
+TEST_F(CompiledCalibration, Eval)
+{
+  auto p = std::make_shared<DAQuiri::Polynomial>(std::vector<double>{5.0, 2.0, 1.0}, 0, 0);
+  DAQuiri::CompiledCalibration cc(p);
+  EXPECT_TRUE(cc.valid());
+  EXPECT_TRUE(cc.flat());
+  EXPECT_EQ(cc(1.0), 8.0);
+  EXPECT_EQ(cc(2.0), 13.0);
+  EXPECT_EQ(cc(3.0), 20.0);
+}
+
+TEST_F(CompiledCalibration, TransformMatchesFunction)
+{
+  auto p = std::make_shared<DAQuiri::Polynomial>();
+  p->set_coeff(0, 1.5);
+  p->set_coeff(1, 0.25);
+  p->set_coeff(3, 0.001);
+  p->x_offset(3.0);
+  DAQuiri::CompiledCalibration cc(p);
+
+  std::vector<double> data(37);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = i * 1.5;
+  auto expected = data;
+  cc.transform(data.data(), data.size());
+
+  for (size_t i = 0; i < data.size(); ++i)
+    EXPECT_NEAR(data[i], (*p)(expected[i]), 1e-9);
+}
+
+TEST_F(CompiledCalibration, Inverse)
+{
+  auto p = std::make_shared<DAQuiri::Polynomial>(std::vector<double>{5.0, 2.0, 1.0}, 0, 0);
+  DAQuiri::CompiledCalibration cc(p);
+  EXPECT_DOUBLE_EQ(cc.inverse(8.0, 0.000000001), 1.0);
+  EXPECT_DOUBLE_EQ(cc.inverse(13.0, 0.000000001), 2.0);
+  EXPECT_DOUBLE_EQ(cc.inverse(20.0, 0.000000001), 3.0);
+  EXPECT_NEAR(cc.inverse((*p)(40000.5), 0.000000001), 40000.5, 1e-6);
+}
+
+TEST_F(CompiledCalibration, InverseDescending)
+{
+  auto p = std::make_shared<DAQuiri::Polynomial>(std::vector<double>{1000.0, -0.5}, 0, 0);
+  DAQuiri::CompiledCalibration cc(p);
+  EXPECT_NEAR(cc.inverse(900.0, 0.000000001), 200.0, 1e-9);
+  EXPECT_NEAR(cc.inverse(2000.0, 0.000000001), -2000.0, 1e-9);
+}
+
+TEST_F(CompiledCalibration, InverseFlatSpot)
+{
+  //(x - 100)^3 has zero slope at its root
+  auto p = std::make_shared<DAQuiri::Polynomial>(
+      std::vector<double>{-1000000.0, 30000.0, -300.0, 1.0}, 0, 0);
+  DAQuiri::CompiledCalibration cc(p);
+  //converges slowly on a triple root, but stays finite
+  EXPECT_NEAR(cc.inverse(0.0, 0.000001), 100.0, 1e-3);
+  EXPECT_NEAR(cc.inverse(8.0, 0.000000001), 102.0, 1e-6);
+
+  //slope is zero at the first table sample
+  auto q = std::make_shared<DAQuiri::Polynomial>(std::vector<double>{0.0, 0.0, 1.0}, 0, 0);
+  DAQuiri::CompiledCalibration cq(q);
+  EXPECT_NEAR(cq.inverse(0.0, 0.000001), 0.0, 1e-6);
+  EXPECT_NEAR(cq.inverse(16.0, 0.000000001), 4.0, 1e-9);
+}
+
+TEST_F(CompiledCalibration, InverseConstant)
+{
+  auto p = std::make_shared<DAQuiri::Polynomial>(std::vector<double>{5.0}, 0, 0);
+  DAQuiri::CompiledCalibration cc(p);
+  EXPECT_TRUE(std::isnan(cc.inverse(5.0, 0.000001)));
+  EXPECT_TRUE(std::isnan(cc.inverse(7.0, 0.000001)));
+}
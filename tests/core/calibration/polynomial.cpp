@@ -74,6 +74,20 @@ TEST_F(Polynomial, Eval)
   EXPECT_EQ(ev[2], 20.0);
 }
 
+TEST_F(Polynomial, EvalSparseWithOffset)
+{
+  DAQuiri::Polynomial cf;
+  cf.set_coeff(0, {1, 1, 1});
+  cf.set_coeff(2, {3, 3, 3});
+  cf.x_offset({1, 1});
+  auto ev = cf.eval({1.0, 2.0, 3.0});
+  ASSERT_EQ(ev.size(), 3u);
+  EXPECT_EQ(ev[0], cf(1.0));
+  EXPECT_EQ(ev[1], cf(2.0));
+  EXPECT_EQ(ev[2], cf(3.0));
+  EXPECT_EQ(ev[2], 13.0);
+}
+
 TEST_F(Polynomial, Inverse)
 {
   DAQuiri::Polynomial cf{{5.0, 2.0, 1.0}, 0, 0};
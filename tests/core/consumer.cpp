@@ -83,6 +83,109 @@ TEST(Consumer, EventsArePushedWhenAccepted)
   EXPECT_EQ(c.accepted_events, 3UL);
 }
 
+TEST(Consumer, GenerationTracksAcceptedSpills)
+{
+  Spill s("", Spill::Type::daq_status);
+  Spill s2("someid", Spill::Type::daq_status);
+
+  MockConsumer c;
+  auto g0 = c.generation();
+
+  c.push_spill(s2);
+  EXPECT_EQ(c.generation(), g0);
+
+  c.push_spill(s);
+  auto g1 = c.generation();
+  EXPECT_GT(g1, g0);
+
+  c.set_attribute(Setting::text("stream_id", "someid"));
+  EXPECT_GT(c.generation(), g1);
+
+  MockConsumer c2(c);
+  EXPECT_EQ(c2.generation(), c.generation());
+}
+
+TEST(Consumer, ChunkedSpill)
+{
+  Spill s("", Spill::Type::daq_status);
+  s.events.reserve(5, Event(EventModel()));
+  for (size_t i = 0; i < 5; ++i)
+    ++s.events;
+  s.events.finalize();
+
+  MockConsumer c;
+  c.accept_events = true;
+  c.push_spill(s, 0, 2);
+  EXPECT_EQ(c.accepted_events, 2UL);
+  EXPECT_EQ(c.profile().spills, 0UL);
+
+  c.push_spill(s, 2, 4);
+  c.push_spill(s, 4, 5);
+  EXPECT_EQ(c.accepted_events, 5UL);
+  EXPECT_EQ(c.accepted_spills, 1UL);
+  EXPECT_EQ(c.profile().spills, 1UL);
+
+  // reconfiguring between chunks skips the rest of the spill's events,
+  // its pre-stats are not repeated
+  c.push_spill(s, 0, 2);
+  c.set_attribute(Setting::text("stream_id", "other"));
+  c.push_spill(s, 2, 5);
+  EXPECT_EQ(c.accepted_events, 7UL);
+  EXPECT_EQ(c.accepted_spills, 2UL);
+}
+
+TEST(Consumer, ChunkOfAnotherSpill)
+{
+  Spill s("", Spill::Type::daq_status);
+  s.events.reserve(4, Event(EventModel()));
+  for (size_t i = 0; i < 4; ++i)
+    ++s.events;
+  s.events.finalize();
+  s.sequence = 1;
+
+  MockConsumer c;
+  c.accept_events = true;
+  c.push_spill(s, 0, 2);
+  EXPECT_EQ(c.accepted_spills, 1UL);
+
+  // same address, different spill: starts over with its pre-stats
+  s.sequence = 2;
+  c.push_spill(s, 2, 4);
+  EXPECT_EQ(c.accepted_spills, 2UL);
+  EXPECT_EQ(c.accepted_events, 4UL);
+}
+
+TEST(Consumer, ProfileCountsSpillsAndEvents)
+{
+  Spill s("", Spill::Type::daq_status);
+  s.events.reserve(3, Event(EventModel()));
+  ++s.events;
+  ++s.events;
+  ++s.events;
+  s.events.finalize();
+
+  MockConsumer c;
+  c.push_spill(s);
+  EXPECT_EQ(c.profile().spills, 1UL);
+  EXPECT_EQ(c.profile().events, 0UL);
+
+  c.accept_events = true;
+  c.push_spill(s);
+  EXPECT_EQ(c.profile().spills, 2UL);
+  EXPECT_EQ(c.profile().events, 3UL);
+
+  auto md = c.metadata();
+  auto attr = md.get_attribute("profile_events");
+  EXPECT_EQ(attr.get_number(), 3);
+  EXPECT_TRUE(attr.metadata().has_flag("readonly"));
+
+  //runtime only, never saved with the consumer
+  json j = md;
+  ConsumerMetadata saved = j;
+  EXPECT_FALSE(saved.get_attribute("profile_events"));
+  EXPECT_TRUE(saved.get_attribute("stream_id"));
+}
+
 //TODO: this is failing
 //TEST(Consumer, ChangeAndReset)
 //{
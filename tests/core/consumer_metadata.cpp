@@ -8,3 +8,50 @@ TEST(ConsumerMetadata, Init)
   ConsumerMetadata m;
   EXPECT_TRUE(m.type().empty());
 }
+
+static ConsumerMetadata make_metadata()
+{
+  ConsumerMetadata m("type", "description");
+  Setting attrs = m.attributes();
+  attrs.branches.add(Setting::integer("a", 1));
+  attrs.branches.add(Setting::text("t", "x"));
+  m.overwrite_all_attributes(attrs);
+  return m;
+}
+
+TEST(ConsumerMetadata, GetSetAttribute)
+{
+  auto m = make_metadata();
+  EXPECT_EQ(m.get_attribute("a").get_int(), 1);
+  EXPECT_FALSE(m.get_attribute("nope"));
+
+  m.set_attribute(Setting::integer("a", 2));
+  EXPECT_EQ(m.get_attribute("a").get_int(), 2);
+
+  // unknown attributes are ignored
+  m.set_attribute(Setting::integer("nope", 2));
+  EXPECT_FALSE(m.get_attribute("nope"));
+}
+
+TEST(ConsumerMetadata, AttributeHandle)
+{
+  auto m = make_metadata();
+  auto h = m.handle("a");
+  ASSERT_NE(m.attribute(h), nullptr);
+  m.attribute(h)->set_int(5);
+  EXPECT_EQ(m.get_attribute("a").get_int(), 5);
+
+  auto missing = m.handle("nope");
+  EXPECT_EQ(m.attribute(missing), nullptr);
+
+  // re-resolved after the tree changes shape
+  m.replace_attribute(Setting::integer("a", 7));
+  ASSERT_NE(m.attribute(h), nullptr);
+  EXPECT_EQ(m.attribute(h)->get_int(), 7);
+
+  // never resolves into another instance
+  auto copy = m;
+  copy.attribute(h)->set_int(8);
+  EXPECT_EQ(copy.get_attribute("a").get_int(), 8);
+  EXPECT_EQ(m.get_attribute("a").get_int(), 7);
+}
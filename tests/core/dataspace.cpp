@@ -7,6 +7,7 @@ class MockDataspace : public Dataspace
 {
   public:
     MockDataspace() {}
+    MockDataspace(uint16_t dimensions) : Dataspace(dimensions) {}
 
     MockDataspace* clone() const override { return new MockDataspace(*this); }
 
@@ -32,6 +33,41 @@ TEST(DataAxis, Init)
   EXPECT_TRUE(a.label().empty());
 }
 
+TEST(DataAxis, FitDomain)
+{
+  DataAxis a(DAQuiri::Calibration(), 1);
+  a.fit_domain(3);
+  ASSERT_EQ(a.domain.size(), 4UL);
+  EXPECT_EQ(a.domain[3], 6.0);
+
+  a.fit_domain(1);
+  ASSERT_EQ(a.domain.size(), 2UL);
+  EXPECT_EQ(a.domain[1], 2.0);
+}
+
+TEST(DataAxis, SameDefinition)
+{
+  DataAxis a(DAQuiri::Calibration({"v1"}, {"v2"}), 1);
+  a.expand_domain(5);
+  EXPECT_TRUE(a.same_definition(DataAxis(DAQuiri::Calibration({"v1"}, {"v2"}), 1)));
+  EXPECT_FALSE(a.same_definition(DataAxis(DAQuiri::Calibration({"v1"}, {"v2"}), 2)));
+  EXPECT_FALSE(a.same_definition(DataAxis(DAQuiri::Calibration({"v1"}, {"v3"}), 1)));
+}
+
+TEST(Dataspace, DefineAxisKeepsDomain)
+{
+  MockDataspace d(1);
+  DataAxis a(DAQuiri::Calibration({"v1"}, {"v2"}), 0);
+  a.expand_domain(9);
+  d.set_axis(0, a);
+
+  d.define_axis(0, DataAxis(DAQuiri::Calibration({"v1"}, {"v2"}), 0));
+  EXPECT_EQ(d.axis(0).domain.size(), 10UL);
+
+  d.define_axis(0, DataAxis(DAQuiri::Calibration({"v1"}, {"v2"}), 1));
+  EXPECT_TRUE(d.axis(0).domain.empty());
+}
+
 TEST(Dataspace, Init)
 {
   MockDataspace d;
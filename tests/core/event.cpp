@@ -38,6 +38,7 @@ TEST(Event, Trace)
   hm.add_trace("wave", {3});
   DAQuiri::Event h(hm);
   ASSERT_ANY_THROW(h.trace(2));
+  EXPECT_TRUE(h.trace(0).empty());
   h.trace(0) = std::vector<uint32_t>({3,6,9});
   ASSERT_EQ(std::vector<uint32_t>({3,6,9}), h.trace(0));
   EXPECT_EQ("[t0|ntraces=1]", h.debug());
@@ -52,3 +52,33 @@ TEST(EventModel, AddTrace)
   ASSERT_EQ("y", h.trace_names.at(1));
   EXPECT_EQ("TRACES x( 2 3 ) y( 2 5 7 ) ", h.debug());
 }
+
+TEST(SharedEventModel, CopiesShareModel)
+{
+  DAQuiri::SharedEventModel empty;
+  EXPECT_EQ(0UL, empty.id());
+  EXPECT_TRUE(empty->values.empty());
+
+  DAQuiri::EventModel h;
+  h.add_value("a", 2);
+  DAQuiri::SharedEventModel a(h);
+  EXPECT_NE(0UL, a.id());
+
+  auto b = a;
+  EXPECT_EQ(a.id(), b.id());
+  EXPECT_EQ(&(*a), &(*b));
+}
+
+TEST(SharedEventModel, EditDetaches)
+{
+  DAQuiri::SharedEventModel a;
+  a.edit().add_value("a", 2);
+  auto b = a;
+  auto old_id = a.id();
+
+  b.edit().add_value("b", 7);
+  EXPECT_NE(old_id, b.id());
+  EXPECT_EQ(old_id, a.id());
+  EXPECT_EQ(1UL, a->values.size());
+  EXPECT_EQ(2UL, b->values.size());
+}
@@ -0,0 +1,168 @@
+#include "gtest_color_print.h"
+#include <core/list_file.h>
+#include <cstdio>
+
+using namespace DAQuiri;
+
+class ListFile : public TestBase
+{
+ protected:
+  virtual void TearDown()
+  {
+    for (const auto& f : files)
+      std::remove(f.c_str());
+  }
+
+  SpillPtr make_spill(std::string stream, size_t events)
+  {
+    auto spill = std::make_shared<Spill>(stream, Spill::Type::running);
+    spill->event_model = model;
+    spill->state.branches.add_a(Setting::integer("native_time", 7));
+    spill->raw = {'a', 'b'};
+    spill->events.reserve(events, Event(*model));
+    for (size_t i = 0; i < events; ++i)
+    {
+      auto& e = spill->events.last();
+      e.set_time(1000 + i);
+      e.set_value(0, i);
+      e.set_value(1, 2 * i);
+      e.trace(0) = std::vector<uint32_t>(i % 5, i);
+      ++spill->events;
+    }
+    spill->events.finalize();
+    return spill;
+  }
+
+  void make_model()
+  {
+    EventModel m;
+    m.add_value("energy", 16);
+    m.add_value("channel", 8);
+    m.add_trace("waveform", {10});
+    model = m;
+  }
+
+  SharedEventModel model;
+  std::vector<std::string> files;
+};
+
+TEST_F(ListFile, RoundTrip)
+{
+  make_model();
+  ListRecorder recorder;
+  recorder.open("", "list_test");
+  files = recorder.files();
+
+  std::vector<SpillPtr> written;
+  written.push_back(make_spill("a", 10));
+  written.push_back(make_spill("b", 0));
+  written.push_back(make_spill("a", 3));
+  for (auto& s : written)
+    ASSERT_TRUE(recorder.record(s));
+  recorder.close();
+  EXPECT_EQ(recorder.spills_written(), 3u);
+
+  ListReader reader(files.at(0));
+  for (auto& w : written)
+  {
+    auto r = reader.next();
+    ASSERT_TRUE(r);
+    EXPECT_EQ(r->stream_id, w->stream_id);
+    EXPECT_EQ(r->type, w->type);
+    EXPECT_EQ(r->time, w->time);
+    EXPECT_EQ(r->state, w->state);
+    EXPECT_EQ(r->raw, w->raw);
+    EXPECT_EQ(r->event_model->value_names, model->value_names);
+    EXPECT_EQ(r->event_model->traces, model->traces);
+    ASSERT_EQ(r->events.size(), w->events.size());
+    auto we = w->events.begin();
+    for (const auto& re : r->events)
+      EXPECT_EQ(re, *we++);
+  }
+  EXPECT_FALSE(reader.next());
+}
+
+TEST_F(ListFile, Rotates)
+{
+  make_model();
+  ListRecorder recorder;
+  recorder.rotate_bytes = 1000;
+  recorder.open("", "list_test");
+  for (size_t i = 0; i < 10; ++i)
+    ASSERT_TRUE(recorder.record(make_spill("a", 20)));
+  recorder.close();
+  files = recorder.files();
+  EXPECT_GT(files.size(), 1u);
+
+  // every file stands alone, with its own event model
+  size_t spills {0};
+  for (const auto& f : files)
+  {
+    ListReader reader(f);
+    while (auto s = reader.next())
+    {
+      EXPECT_EQ(s->events.size(), 20u);
+      EXPECT_EQ(s->event_model->value_names, model->value_names);
+      spills++;
+    }
+  }
+  EXPECT_EQ(spills, 10u);
+}
+
+TEST_F(ListFile, BoundedTail)
+{
+  make_model();
+  ListRecorder recorder;
+  recorder.tail_spills = 3;
+  recorder.open("", "list_test");
+  files = recorder.files();
+  SpillPtr last;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    last = make_spill("a", 1);
+    recorder.record(last);
+  }
+  auto tail = recorder.tail();
+  ASSERT_EQ(tail.size(), 3u);
+  EXPECT_EQ(tail.back(), last);
+}
+
+TEST_F(ListFile, Truncated)
+{
+  make_model();
+  ListRecorder recorder;
+  recorder.open("", "list_test");
+  files = recorder.files();
+  recorder.record(make_spill("a", 100));
+  recorder.close();
+
+  std::string path = files.at(0);
+  std::ifstream in(path, std::ios::binary);
+  std::string contents((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(contents.data(), contents.size() / 2);
+  out.close();
+
+  ListReader reader(path);
+  EXPECT_ANY_THROW(reader.next());
+  EXPECT_ANY_THROW(ListReader("no_such.daqlist"));
+}
+
+TEST_F(ListFile, Sequence)
+{
+  make_model();
+  ListRecorder recorder;
+  recorder.rotate_bytes = 1;
+  recorder.open("", "list_test");
+  for (size_t i = 0; i < 3; ++i)
+    recorder.record(make_spill("a", 1));
+  recorder.close();
+  files = recorder.files();
+  ASSERT_EQ(files.size(), 3u);
+
+  EXPECT_EQ(ListReader::sequence(files.at(0)), files);
+  EXPECT_EQ(ListReader::sequence(files.at(1)).size(), 2u);
+  EXPECT_EQ(ListReader::sequence("other.daqlist").size(), 1u);
+}
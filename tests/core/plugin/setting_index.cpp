@@ -0,0 +1,75 @@
+#include <core/plugin/setting_index.h>
+#include <gtest/gtest.h>
+
+using namespace DAQuiri;
+
+static Setting make_tree()
+{
+  Setting root = Setting::stem("root");
+  root.branches.add_a(Setting::integer("a", 1));
+
+  Setting sub = Setting::stem("sub");
+  Setting b0 = Setting::integer("b", 10);
+  b0.set_indices({0});
+  Setting b1 = Setting::integer("b", 11);
+  b1.set_indices({1});
+  sub.branches.add_a(b0);
+  sub.branches.add_a(b1);
+  root.branches.add_a(sub);
+
+  // nested node sharing its parent's id
+  Setting outer = Setting::stem("c");
+  outer.branches.add_a(Setting::stem("c"));
+  root.branches.add_a(outer);
+  return root;
+}
+
+TEST(SettingIndex, MatchesFind)
+{
+  auto root = make_tree();
+  SettingIndex index(root);
+  EXPECT_EQ(index.size(), 7u);
+
+  auto a = index.find(Setting("a"));
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(a->get_int(), 1);
+
+  Setting b("b");
+  b.set_indices({1});
+  auto bb = index.find(b, Match::id | Match::indices);
+  ASSERT_NE(bb, nullptr);
+  EXPECT_EQ(*bb, root.find(b, Match::id | Match::indices));
+  EXPECT_EQ(index.find_all(Setting("b")).size(), 2u);
+
+  EXPECT_EQ(index.find(Setting("nope")), nullptr);
+  EXPECT_ANY_THROW(index.find(Setting("a"), Match::indices));
+}
+
+TEST(SettingIndex, SameOrderAsTree)
+{
+  auto root = make_tree();
+  SettingIndex index(root);
+
+  // find visits children first, set visits parents first
+  auto found = index.find(Setting("c"));
+  ASSERT_NE(found, nullptr);
+  EXPECT_TRUE(found->branches.empty());
+
+  auto target = index.find_for_set(Setting("c"));
+  ASSERT_NE(target, nullptr);
+  EXPECT_FALSE(target->branches.empty());
+}
+
+TEST(SettingIndex, NodesAreLive)
+{
+  auto root = make_tree();
+  SettingIndex index(root);
+
+  index.find(Setting("a"))->set_int(42);
+  EXPECT_EQ(root.find(Setting("a")).get_int(), 42);
+
+  root.erase(Setting("a"));
+  index.rebuild(root);
+  EXPECT_EQ(index.find(Setting("a")), nullptr);
+  EXPECT_EQ(index.size(), 6u);
+}
@@ -1,3 +1,89 @@
 #include <gtest/gtest.h>
 #include <core/project.h>
 
+#include <consumers/dataspaces/dense1d.h>
+
+using namespace DAQuiri;
+
+class RoutedConsumer : public Consumer
+{
+  public:
+    RoutedConsumer(std::string stream, std::string extra = "")
+    {
+      data_ = std::make_shared<Dense1D>();
+
+      Setting attributes = metadata_.attributes();
+      SettingMeta other("other_stream_id", SettingType::text, "Other stream ID");
+      other.set_flag("stream");
+      attributes.branches.add(other);
+      metadata_.overwrite_all_attributes(attributes);
+
+      set_attribute(Setting::text("stream_id", stream));
+      set_attribute(Setting::text("other_stream_id", extra));
+    }
+    RoutedConsumer* clone() const override { return new RoutedConsumer(*this); }
+
+    size_t visits{0};
+
+  protected:
+    std::string my_type() const override { return "RoutedConsumer"; }
+    void _recalc_axes() override {}
+    bool _accept_spill(const Spill& spill) override
+    {
+      visits++;
+      return Consumer::_accept_spill(spill);
+    }
+    bool _accept_events(const Spill&) override { return false; }
+    void _push_event(const Event&) override {}
+};
+
+TEST(Project, RoutesSpillsByStream)
+{
+  auto a = std::make_shared<RoutedConsumer>("a");
+  auto b = std::make_shared<RoutedConsumer>("b");
+  auto c = std::make_shared<RoutedConsumer>("c", "a");
+
+  Project p;
+  p.add_consumer(a);
+  p.add_consumer(b);
+  p.add_consumer(c);
+
+  // unset stream attributes route engine spills, which get rejected
+  EXPECT_EQ(a->streams(), std::set<std::string>({"", "a"}));
+  EXPECT_EQ(c->streams(), std::set<std::string>({"a", "c"}));
+
+  p.add_spill(std::make_shared<Spill>("a", Spill::Type::running));
+  EXPECT_LT(0u, a->visits);
+  EXPECT_EQ(0u, b->visits);
+  EXPECT_LT(0u, c->visits);
+
+  // nobody listens
+  auto visits = a->visits;
+  p.add_spill(std::make_shared<Spill>("z", Spill::Type::running));
+  EXPECT_EQ(visits, a->visits);
+}
+
+TEST(Project, RoutesFollowChanges)
+{
+  auto a = std::make_shared<RoutedConsumer>("a");
+  auto b = std::make_shared<RoutedConsumer>("b");
+
+  Project p;
+  p.add_consumer(a);
+  p.add_spill(std::make_shared<Spill>("b", Spill::Type::running));
+  EXPECT_EQ(0u, a->visits);
+
+  // attribute changed behind the project's back
+  a->set_attribute(Setting::text("stream_id", "b"));
+  p.add_spill(std::make_shared<Spill>("b", Spill::Type::running));
+  EXPECT_LT(0u, a->visits);
+
+  p.add_consumer(b);
+  p.add_spill(std::make_shared<Spill>("b", Spill::Type::running), 1);
+  EXPECT_LT(0u, b->visits);
+
+  p.delete_consumer(0);
+  auto visits = a->visits;
+  p.add_spill(std::make_shared<Spill>("b", Spill::Type::running));
+  EXPECT_EQ(visits, a->visits);
+}
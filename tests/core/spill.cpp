@@ -31,6 +31,23 @@ TEST_F(EventBuffer, reserve)
   EXPECT_EQ(eb.last().value_count(), 1UL);
 }
 
+TEST_F(EventBuffer, recycle)
+{
+  DAQuiri::EventBuffer eb;
+  eb.reserve(10, e);
+  eb.last().set_value(0, 42);
+  ++eb;
+  eb.recycle();
+  EXPECT_TRUE(eb.empty());
+
+  eb.reserve(4, e);
+  EXPECT_EQ(eb.size(), 4UL);
+  EXPECT_EQ(eb.last().value(0), 0U);
+
+  eb.reserve(12, e);
+  EXPECT_EQ(eb.size(), 12UL);
+}
+
 TEST_F(EventBuffer, finalize)
 {
   DAQuiri::EventBuffer eb;
@@ -0,0 +1,97 @@
+#include "gtest_color_print.h"
+#include <core/spill_cache.h>
+
+using namespace DAQuiri;
+
+class SpillCacheTest : public TestBase
+{
+ protected:
+  virtual void SetUp()
+  {
+    EventModel m;
+    m.add_value("energy", 16);
+    m.add_value("adc", 16);
+    spill.event_model = m;
+    spill.events.reserve(10, Event(m));
+    for (size_t i = 0; i < 10; ++i)
+    {
+      auto& e = spill.events.last();
+      e.set_value(0, 100 * i);
+      e.set_value(1, i);
+      ++spill.events;
+    }
+    spill.events.finalize();
+  }
+
+  Spill spill;
+  SpillCache cache;
+};
+
+TEST_F(SpillCacheTest, OnlyCurrentSpill)
+{
+  SpillCache::Selection s {{1, 2, 5}};
+  EXPECT_FALSE(cache.mask(spill, s, 10));
+  EXPECT_FALSE(cache.column(spill, 0, 0, 10));
+
+  cache.reset(&spill);
+  EXPECT_TRUE(cache.mask(spill, s, 10));
+
+  Spill other;
+  EXPECT_FALSE(cache.mask(other, s, 10));
+
+  cache.reset();
+  EXPECT_FALSE(cache.mask(spill, s, 10));
+  EXPECT_EQ(cache.masks(), 0u);
+}
+
+TEST_F(SpillCacheTest, Mask)
+{
+  cache.reset(&spill);
+  auto m = cache.mask(spill, {{1, 2, 5}, {0, 0, 400}}, 10);
+  ASSERT_TRUE(m);
+  std::vector<uint8_t> expected {0, 0, 1, 1, 1, 0, 0, 0, 0, 0};
+  EXPECT_EQ(std::vector<uint8_t>(m, m + 10), expected);
+}
+
+TEST_F(SpillCacheTest, SharedOnce)
+{
+  cache.reset(&spill);
+  auto a = cache.mask(spill, {{1, 2, 5}}, 10);
+  auto b = cache.mask(spill, {{1, 2, 5}}, 10);
+  auto c = cache.mask(spill, {{1, 2, 6}}, 10);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(cache.masks(), 2u);
+
+  auto x = cache.column(spill, 0, 2, 10);
+  auto y = cache.column(spill, 0, 2, 10);
+  cache.column(spill, 0, 3, 10);
+  EXPECT_EQ(x, y);
+  //filters on adc read its unshifted column
+  EXPECT_EQ(cache.columns(), 3u);
+  EXPECT_EQ(cache.hits(), 2u);
+
+  for (size_t i = 0; i < 10; ++i)
+    EXPECT_EQ(x[i], (100 * i) >> 2);
+}
+
+TEST_F(SpillCacheTest, Chunked)
+{
+  cache.reset(&spill);
+  SpillCache::Selection s {{1, 3, 7}};
+  cache.mask(spill, s, 4);
+  EXPECT_EQ(cache.hits(), 0u);
+  cache.column(spill, 1, 0, 4);
+  EXPECT_EQ(cache.hits(), 1u);
+
+  //first consumer extends, the next one finds it done
+  auto m = cache.mask(spill, s, 10);
+  EXPECT_EQ(cache.mask(spill, s, 8), m);
+  EXPECT_EQ(cache.hits(), 2u);
+  std::vector<uint8_t> expected {0, 0, 0, 1, 1, 1, 1, 1, 0, 0};
+  EXPECT_EQ(std::vector<uint8_t>(m, m + 10), expected);
+
+  auto c = cache.column(spill, 1, 0, 10);
+  for (size_t i = 0; i < 10; ++i)
+    EXPECT_EQ(c[i], i);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <core/spill_dequeue.h>
+#include <thread>
 
 using namespace DAQuiri;
 
@@ -9,3 +10,142 @@ TEST(SpillDeque, Init)
   EXPECT_EQ(sd.size(), 0UL);
 }
 
+
+TEST(SpillMultiqueue, LatencyStats)
+{
+  SpillMultiqueue q(false, 10);
+  q.enqueue(std::make_shared<Spill>("a", Spill::Type::running));
+  q.enqueue(std::make_shared<Spill>("b", Spill::Type::running));
+
+  auto s = q.dequeue();
+  q.processed(s->stream_id, std::chrono::system_clock::now());
+
+  Setting stats = Setting::stem("stats");
+  q.latency_stats(stats);
+  EXPECT_TRUE(stats.find(Setting("a_enqueue_p50")));
+  EXPECT_TRUE(stats.find(Setting("a_residency_p99")));
+  EXPECT_TRUE(stats.find(Setting("a_processing_max")));
+  EXPECT_TRUE(stats.find(Setting("b_enqueue_max")));
+}
+
+SpillPtr timed_spill(std::string stream, double native_time)
+{
+  auto s = std::make_shared<Spill>(stream, Spill::Type::running);
+  s->state.branches.add(Setting::precise("native_time", native_time));
+  return s;
+}
+
+TEST(SpillMultiqueue, MergeByEventTime)
+{
+  SpillMultiqueue q(false, 10);
+  q.merge_by_event_time(0, std::chrono::milliseconds(0), 10);
+  q.enqueue(timed_spill("a", 30));
+  q.enqueue(timed_spill("b", 10));
+  q.enqueue(timed_spill("a", 40));
+  q.enqueue(timed_spill("b", 20));
+
+  EXPECT_EQ(q.dequeue()->stream_id, "b");
+  EXPECT_EQ(q.dequeue()->stream_id, "b");
+  EXPECT_EQ(q.dequeue()->stream_id, "a");
+  EXPECT_EQ(q.dequeue()->stream_id, "a");
+  EXPECT_EQ(q.late_spills(), 0UL);
+
+  q.enqueue(timed_spill("b", 5));
+  EXPECT_EQ(q.dequeue()->stream_id, "b");
+  EXPECT_EQ(q.late_spills(), 1UL);
+}
+
+TEST(SpillMultiqueue, ReorderLimitForcesRelease)
+{
+  SpillMultiqueue q(false, 10);
+  q.merge_by_event_time(1e12, std::chrono::hours(1), 2);
+  q.enqueue(timed_spill("a", 10));
+  q.enqueue(timed_spill("b", 20));
+  q.enqueue(timed_spill("a", 30));
+
+  EXPECT_EQ(q.dequeue()->stream_id, "a");
+  EXPECT_EQ(q.forced_spills(), 1UL);
+  EXPECT_EQ(q.size(), 2UL);
+}
+
+TEST(SpillMultiqueue, TryDequeueDoesNotWaitForHeldSpills)
+{
+  SpillMultiqueue q(false, 10);
+  q.merge_by_event_time(1e12, std::chrono::hours(1), 10);
+  q.enqueue(timed_spill("a", 10));
+  q.enqueue(timed_spill("b", 20));
+
+  auto before = std::chrono::steady_clock::now();
+  EXPECT_FALSE(q.try_dequeue());
+  EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::seconds(5));
+  EXPECT_EQ(q.size(), 2UL);
+}
+
+TEST(SpillMultiqueue, HoldIsWallClock)
+{
+  SpillMultiqueue q(false, 10);
+  q.merge_by_event_time(1e12, std::chrono::milliseconds(0), 10);
+  q.enqueue(timed_spill("a", 10));
+
+  //lateness is far off in event time, but nothing is held on the wall clock
+  ASSERT_TRUE(q.try_dequeue());
+  EXPECT_EQ(q.forced_spills(), 1UL);
+}
+
+TEST(SpillMultiqueue, ActivityWakesControl)
+{
+  SpillMultiqueue q(false, 10);
+  uint64_t seen = q.activity();
+
+  //nothing happened, times out
+  q.wait_activity(seen, std::chrono::milliseconds(1));
+  EXPECT_EQ(seen, q.activity());
+
+  auto t = std::thread([&q]
+                       {
+                         std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                         q.enqueue(std::make_shared<Spill>("a", Spill::Type::start));
+                         q.notify();
+                       });
+  auto before = std::chrono::steady_clock::now();
+  q.wait_activity(seen, std::chrono::seconds(10));
+  EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::seconds(5));
+  t.join();
+  EXPECT_NE(q.first_spill(), hr_time_t());
+}
+
+TEST(SpillMultiqueue, WaitEmpty)
+{
+  SpillMultiqueue q(false, 10);
+  q.enqueue(std::make_shared<Spill>());
+  EXPECT_EQ(q.first_spill(), hr_time_t());
+
+  q.enqueue(std::make_shared<Spill>("a", Spill::Type::running));
+  auto t = std::thread([&q]
+                       {
+                         while (q.dequeue())
+                           ;
+                       });
+  q.wait_empty();
+  EXPECT_EQ(q.size(), 0UL);
+  q.stop();
+  t.join();
+}
+
+TEST(SpillMultiqueue, WaitBelow)
+{
+  SpillMultiqueue q(false, 10);
+  EXPECT_TRUE(q.wait_below(1, std::chrono::milliseconds(0)));
+
+  q.enqueue(std::make_shared<Spill>("a", Spill::Type::running));
+  q.enqueue(std::make_shared<Spill>("a", Spill::Type::running));
+  EXPECT_FALSE(q.wait_below(2, std::chrono::milliseconds(10)));
+
+  // woken as soon as a spill is taken, not at the timeout
+  auto t = std::thread([&q] { q.dequeue(); });
+  auto before = std::chrono::steady_clock::now();
+  EXPECT_TRUE(q.wait_below(2, std::chrono::seconds(10)));
+  EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::seconds(5));
+  t.join();
+  EXPECT_EQ(q.size(), 1UL);
+}
@@ -0,0 +1,67 @@
+#include "gtest_color_print.h"
+#include <core/spill_pool.h>
+
+class SpillPool : public TestBase
+{
+ protected:
+  virtual void SetUp()
+  {
+    pool().clear();
+    pool().set_capacity(64);
+  }
+
+  DAQuiri::SpillPool& pool()
+  {
+    return DAQuiri::SpillPool::singleton();
+  }
+};
+
+TEST_F(SpillPool, NewSpill)
+{
+  auto misses = pool().misses();
+  auto s = pool().get("a", DAQuiri::Spill::Type::running);
+  EXPECT_EQ(pool().misses(), misses + 1);
+  EXPECT_EQ(s->stream_id, "a");
+  EXPECT_EQ(s->type, DAQuiri::Spill::Type::running);
+  EXPECT_TRUE(s->state);
+  EXPECT_TRUE(s->events.empty());
+}
+
+TEST_F(SpillPool, Recycles)
+{
+  DAQuiri::Spill* raw_ptr {nullptr};
+  {
+    auto s = pool().get("a", DAQuiri::Spill::Type::running);
+    raw_ptr = s.get();
+    s->event_model.edit().add_value("val", 100);
+    s->events.reserve(10, *s->event_model);
+    s->raw = {1, 2, 3};
+    s->state.branches.add_a(DAQuiri::Setting::integer("x", 1));
+  }
+  EXPECT_EQ(pool().available(), 1UL);
+
+  auto hits = pool().hits();
+  auto s = pool().get("b", DAQuiri::Spill::Type::daq_status);
+  EXPECT_EQ(pool().hits(), hits + 1);
+  EXPECT_EQ(s.get(), raw_ptr);
+  EXPECT_EQ(s->stream_id, "b");
+  EXPECT_EQ(s->type, DAQuiri::Spill::Type::daq_status);
+  EXPECT_FALSE(s->state);
+  EXPECT_TRUE(s->raw.empty());
+  EXPECT_TRUE(s->events.empty());
+  EXPECT_EQ(s->event_model->values.size(), 0UL);
+  EXPECT_EQ(pool().available(), 0UL);
+}
+
+TEST_F(SpillPool, Capacity)
+{
+  pool().set_capacity(1);
+  {
+    auto s1 = pool().get("a", DAQuiri::Spill::Type::running);
+    auto s2 = pool().get("a", DAQuiri::Spill::Type::running);
+  }
+  EXPECT_EQ(pool().available(), 1UL);
+
+  pool().set_capacity(0);
+  EXPECT_EQ(pool().available(), 0UL);
+}
@@ -0,0 +1,52 @@
+#include "gtest_color_print.h"
+#include <core/util/latency_histogram.h>
+
+class LatencyHistogramTest : public TestBase
+{
+};
+
+TEST_F(LatencyHistogramTest, Empty)
+{
+  LatencyHistogram h;
+  EXPECT_EQ(h.count(), 0UL);
+  EXPECT_EQ(h.max(), 0UL);
+  EXPECT_EQ(h.percentile(50), 0UL);
+}
+
+TEST_F(LatencyHistogramTest, ExactBelow32)
+{
+  LatencyHistogram h;
+  for (uint64_t i = 1; i <= 20; ++i)
+    h.add(i);
+  EXPECT_EQ(h.count(), 20UL);
+  EXPECT_EQ(h.percentile(50), 10UL);
+  EXPECT_EQ(h.percentile(100), 20UL);
+  EXPECT_EQ(h.max(), 20UL);
+}
+
+TEST_F(LatencyHistogramTest, RelativePrecision)
+{
+  LatencyHistogram h;
+  for (uint64_t i = 1; i <= 1000000; i += 7)
+    h.add(i);
+  auto p50 = h.percentile(50);
+  EXPECT_GE(p50, 500000UL);
+  EXPECT_LE(p50, 500000UL * 107 / 100);
+  auto p99 = h.percentile(99);
+  EXPECT_GE(p99, 990000UL);
+  EXPECT_LE(p99, h.max());
+}
+
+TEST_F(LatencyHistogramTest, Merge)
+{
+  LatencyHistogram a, b;
+  a.add(5);
+  b.add(7000);
+  a.add(b);
+  EXPECT_EQ(a.count(), 2UL);
+  EXPECT_EQ(a.max(), 7000UL);
+  EXPECT_EQ(a.percentile(0), 5UL);
+
+  a.clear();
+  EXPECT_EQ(a.count(), 0UL);
+}
@@ -0,0 +1,85 @@
+#include "gtest_color_print.h"
+#include <core/util/log_limiter.h>
+#include <thread>
+
+class LogLimiterTest : public TestBase
+{
+};
+
+TEST_F(LogLimiterTest, Burst)
+{
+  LogLimiter l(3, std::chrono::hours(1));
+  uint64_t suppressed {0};
+  for (size_t i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(l.allow(suppressed));
+    EXPECT_EQ(suppressed, 0UL);
+  }
+  for (size_t i = 0; i < 100; ++i)
+    EXPECT_FALSE(l.allow(suppressed));
+  EXPECT_EQ(l.total(), 103UL);
+  EXPECT_EQ(l.suppressed(), 100UL);
+}
+
+TEST_F(LogLimiterTest, ReportsSuppressed)
+{
+  LogLimiter l(1, std::chrono::milliseconds(20));
+  uint64_t suppressed {0};
+  EXPECT_TRUE(l.allow(suppressed));
+  EXPECT_FALSE(l.allow(suppressed));
+  EXPECT_FALSE(l.allow(suppressed));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_TRUE(l.allow(suppressed));
+  EXPECT_EQ(suppressed, 2UL);
+  EXPECT_EQ(l.suppressed(), 0UL);
+  EXPECT_EQ(l.total(), 4UL);
+}
+
+TEST_F(LogLimiterTest, TakeSuppressed)
+{
+  LogLimiter l(0);
+  uint64_t suppressed {0};
+  EXPECT_FALSE(l.allow(suppressed));
+  EXPECT_FALSE(l.allow(suppressed));
+  EXPECT_EQ(l.take_suppressed(), 2UL);
+  EXPECT_EQ(l.take_suppressed(), 0UL);
+}
+
+TEST_F(LogLimiterTest, TakeExpired)
+{
+  LogLimiter l(1, std::chrono::milliseconds(20));
+  uint64_t suppressed {0};
+  EXPECT_TRUE(l.allow(suppressed));
+  EXPECT_FALSE(l.allow(suppressed));
+  EXPECT_FALSE(l.allow(suppressed));
+  EXPECT_EQ(l.take_expired(), 0UL);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(l.take_expired(), 2UL);
+  EXPECT_EQ(l.take_expired(), 0UL);
+  EXPECT_TRUE(l.allow(suppressed));
+  EXPECT_EQ(suppressed, 0UL);
+}
+
+TEST_F(LogLimiterTest, Reset)
+{
+  LogLimiter l(1, std::chrono::hours(1));
+  uint64_t suppressed {0};
+  EXPECT_TRUE(l.allow(suppressed));
+  EXPECT_FALSE(l.allow(suppressed));
+  l.reset();
+  EXPECT_EQ(l.total(), 0UL);
+  EXPECT_EQ(l.suppressed(), 0UL);
+  EXPECT_TRUE(l.allow(suppressed));
+  EXPECT_EQ(l.total(), 1UL);
+}
+
+TEST_F(LogLimiterTest, Macro)
+{
+  LogLimiter l(2, std::chrono::hours(1));
+  for (size_t i = 0; i < 10; ++i)
+    WARN_LIMITED(l, "<LogLimiterTest> occurrence {}", i);
+  EXPECT_EQ(l.total(), 10UL);
+  EXPECT_EQ(l.suppressed(), 8UL);
+}
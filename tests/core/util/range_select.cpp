@@ -0,0 +1,64 @@
+#include "gtest_color_print.h"
+#include <core/util/range_select.h>
+#include <limits>
+#include <random>
+#include <vector>
+
+class RangeSelectTest : public TestBase
+{
+ protected:
+  std::vector<uint32_t> random_values(size_t count)
+  {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<uint32_t> dist(0, 1000);
+    std::vector<uint32_t> ret(count);
+    for (auto& v : ret)
+      v = dist(gen);
+    //extremes, to catch signed compares
+    ret[0] = 0;
+    ret[count / 2] = std::numeric_limits<uint32_t>::max();
+    return ret;
+  }
+};
+
+TEST_F(RangeSelectTest, Scalar)
+{
+  std::vector<uint32_t> values {0, 5, 10, 15, 20};
+  std::vector<uint8_t> mask(values.size(), 1);
+  select_within_scalar(values.data(), values.size(), 5, 15, mask.data());
+  EXPECT_EQ(mask, std::vector<uint8_t>({0, 1, 1, 1, 0}));
+
+  //ranges are ANDed
+  select_within_scalar(values.data(), values.size(), 10, 100, mask.data());
+  EXPECT_EQ(mask, std::vector<uint8_t>({0, 0, 1, 1, 0}));
+
+  select_within_scalar(values.data(), values.size(), 10, 9, mask.data());
+  EXPECT_EQ(mask, std::vector<uint8_t>(values.size(), 0));
+}
+
+TEST_F(RangeSelectTest, MatchesScalar)
+{
+  //odd length leaves a scalar tail behind the vector loop
+  auto values = random_values(1037);
+  for (auto range : std::vector<std::pair<uint32_t, uint32_t>>
+      {{0, 0}, {100, 600}, {0, std::numeric_limits<uint32_t>::max()},
+       {500, 499}, {2000000000, std::numeric_limits<uint32_t>::max()}})
+  {
+    std::vector<uint8_t> fast(values.size(), 1);
+    std::vector<uint8_t> slow(values.size(), 1);
+    fast[3] = slow[3] = 0;
+    select_within(values.data(), values.size(), range.first, range.second, fast.data());
+    select_within_scalar(values.data(), values.size(), range.first, range.second, slow.data());
+    EXPECT_EQ(fast, slow);
+  }
+}
+
+TEST_F(RangeSelectTest, Unaligned)
+{
+  auto values = random_values(200);
+  std::vector<uint8_t> fast(values.size(), 1);
+  std::vector<uint8_t> slow(values.size(), 1);
+  select_within(values.data() + 3, 150, 200, 800, fast.data() + 5);
+  select_within_scalar(values.data() + 3, 150, 200, 800, slow.data() + 5);
+  EXPECT_EQ(fast, slow);
+}
@@ -0,0 +1,121 @@
+#include "gtest_color_print.h"
+#include <producers/ESSStream/ESSGeometryPlugin.h>
+
+class ESSGeometryPluginTest : public TestBase
+{
+ protected:
+  void configure(ESSGeometryPlugin& g, integer_t lookup_limit)
+  {
+    std::string r{g.plugin_name()};
+    auto s = g.settings();
+    s.set(Setting::integer(r + "/extent_x", 10));
+    s.set(Setting::integer(r + "/extent_y", 5));
+    s.set(Setting::integer(r + "/extent_z", 2));
+    s.set(Setting::integer(r + "/panels", 3));
+    s.set(Setting::integer(r + "/lookup_limit", lookup_limit));
+    g.settings(s);
+    EventModel m;
+    g.define(m);
+    model = m;
+  }
+
+  ESSGeometryPlugin table;
+  ESSGeometryPlugin arithmetic;
+  SharedEventModel model;
+};
+
+TEST_F(ESSGeometryPluginTest, LookupLimit)
+{
+  configure(table, 1000);
+  EXPECT_TRUE(table.has_lookup());
+  configure(arithmetic, 300);
+  EXPECT_FALSE(arithmetic.has_lookup());
+  EXPECT_EQ(arithmetic.settings().find({"ESSGeometry/lookup_limit"}).get_int(), 300);
+}
+
+TEST_F(ESSGeometryPluginTest, SameAsArithmetic)
+{
+  configure(table, 1000);
+  configure(arithmetic, 0);
+
+  size_t valid {0};
+  for (uint32_t id = 0; id < 400; ++id)
+  {
+    Event a(*model);
+    Event b(*model);
+    bool fa = table.fill(a, id);
+    EXPECT_EQ(fa, arithmetic.fill(b, id)) << "id=" << id;
+    if (fa)
+    {
+      EXPECT_EQ(a, b) << "id=" << id;
+      valid++;
+    }
+  }
+  EXPECT_EQ(valid, 300u);
+}
+
+TEST_F(ESSGeometryPluginTest, BulkFill)
+{
+  configure(table, 1000);
+  std::vector<uint32_t> ids {1, 0, 300, 301, 42, 100000};
+  std::vector<uint64_t> times {10, 11, 12, 13, 14, 15};
+
+  EventBuffer events;
+  events.reserve(ids.size(), Event(*model));
+  std::vector<uint32_t> rejected;
+  auto n = table.fill(events, times.data(), ids.data(), ids.size(),
+                      [&rejected](uint32_t id) { rejected.push_back(id); });
+  events.finalize();
+
+  EXPECT_EQ(n, 3u);
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(rejected, std::vector<uint32_t>({0, 301, 100000}));
+
+  std::vector<uint64_t> kept {10, 12, 14};
+  auto t = kept.begin();
+  for (const auto& e : events)
+    EXPECT_EQ(e.timestamp(), *t++);
+
+  Event single(*model);
+  table.fill(single, 42);
+  EXPECT_EQ((events.begin() + 2)->value(0), single.value(0));
+  EXPECT_EQ((events.begin() + 2)->value(3), single.value(3));
+}
+
+TEST_F(ESSGeometryPluginTest, BulkSameAsPerEvent)
+{
+  configure(table, 1000);
+  configure(arithmetic, 0);
+
+  const size_t count = 3000;
+  std::vector<uint32_t> ids(count);
+  std::vector<uint64_t> times(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    ids[i] = 1 + (i * 7919) % 300;
+    times[i] = i;
+  }
+
+  EventBuffer events;
+  events.reserve(count, Event(*model));
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto& e = events.last();
+    if (arithmetic.fill(e, ids[i]))
+    {
+      e.set_time(times[i]);
+      ++events;
+    }
+  }
+  events.finalize();
+  auto expected = std::vector<Event>(events.begin(), events.end());
+
+  events.recycle();
+  events.reserve(count, Event(*model));
+  auto n = table.fill(events, times.data(), ids.data(), count, [](uint32_t) {});
+  events.finalize();
+
+  EXPECT_EQ(n, count);
+  ASSERT_EQ(expected.size(), count);
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), events.begin()));
+}
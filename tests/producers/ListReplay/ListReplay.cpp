@@ -0,0 +1,71 @@
+#include "gtest_color_print.h"
+#include <producers/ListReplay/ListReplay.h>
+#include <core/spill_dequeue.h>
+#include <core/util/timer.h>
+#include <cstdio>
+
+class ListReplayTest : public TestBase
+{
+ protected:
+  virtual void SetUp()
+  {
+    EventModel m;
+    m.add_value("energy", 16);
+    SharedEventModel model = m;
+
+    ListRecorder recorder;
+    recorder.open("", "replay_test");
+    files = recorder.files();
+    for (size_t i = 0; i < 3; ++i)
+    {
+      auto spill = std::make_shared<Spill>("a", Spill::Type::running);
+      spill->event_model = model;
+      spill->events.reserve(2, Event(*model));
+      ++spill->events;
+      ++spill->events;
+      spill->events.finalize();
+      recorder.record(spill);
+    }
+    recorder.close();
+  }
+
+  virtual void TearDown()
+  {
+    for (const auto& f : files)
+      std::remove(f.c_str());
+  }
+
+  // runs a replay to the end, returns the number of spills it produced
+  size_t replay(ListReplay& r)
+  {
+    SpillMultiqueue q(false, 100);
+    if (!r.daq_start(&q))
+      return 0;
+    Timer timer(true);
+    while (r.daq_running() && (timer.s() < 10))
+      Timer::wait_ms(1);
+    size_t ret {0};
+    while (q.try_dequeue())
+      ret++;
+    return ret;
+  }
+
+  std::vector<std::string> files;
+};
+
+TEST_F(ListReplayTest, ReplaysTwice)
+{
+  ListReplay r;
+  std::string id{r.plugin_name()};
+  auto s = r.settings();
+  s.set(Setting::text(id + "/Path", files.at(0)));
+  r.settings(s);
+  r.boot();
+  ASSERT_TRUE(r.status() & ProducerStatus::can_run);
+
+  EXPECT_EQ(replay(r), 3UL);
+  EXPECT_FALSE(r.daq_running());
+
+  // the finished runner thread is joined before the next one starts
+  EXPECT_EQ(replay(r), 3UL);
+}